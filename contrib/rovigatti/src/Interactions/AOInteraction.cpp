@@ -64,6 +64,35 @@ number AOInteraction::pair_interaction_bonded(BaseParticle *p, BaseParticle *q,
 	return (number) 0.f;
 }
 
+number AOInteraction::_AO_energy(number r_norm, number *force_over_r) {
+	number energy = 0;
+	number force = 0;
+	number r_mod = sqrt(r_norm);
+	if(r_norm < _rep_rcut_sqr) {
+		number WCA_part = CUB(_colloid_sigma_sqr / r_norm);
+		number WCA = 4 * (SQR(WCA_part) - WCA_part + 0.25);
+		number S_part = SQR(SQR(r_mod - _rep_rcut));
+		number S = S_part / (_h_zausch_4 + S_part);
+		energy += WCA * S;
+
+		if(force_over_r != NULL) {
+			number WCA_der = 24. * (WCA_part - 2 * SQR(WCA_part)) / r_mod;
+			number S_der = (1 - S) * (4 * CUB(r_mod - _rep_rcut)) / (_h_zausch_4 + S_part);
+			force -= WCA_der * S + WCA * S_der;
+		}
+	}
+
+	number r_rescaled = r_mod / _sigma_colloid_polymer;
+	energy += -_attraction_strength * (1. - 3. / 4. * r_rescaled + CUB(r_rescaled) / 16.);
+
+	if(force_over_r != NULL) {
+		force -= _attraction_strength * (3. / 4. - 3. * SQR(r_rescaled) / 16.) / _sigma_colloid_polymer;
+		*force_over_r = force / r_mod;
+	}
+
+	return energy;
+}
+
 number AOInteraction::pair_interaction_nonbonded(BaseParticle *p, BaseParticle *q, bool compute_r, bool update_forces) {
 	if(compute_r) {
 		_computed_r = this->_box->min_image(p->pos, q->pos);
@@ -73,33 +102,41 @@ number AOInteraction::pair_interaction_nonbonded(BaseParticle *p, BaseParticle *
 	number energy = 0;
 
 	if(r_norm < this->_sqr_rcut) {
-		number r_mod = sqrt(r_norm);
-		if(r_norm < _rep_rcut_sqr) {
-			number WCA_part = CUB(_colloid_sigma_sqr / r_norm);
-			number WCA = 4 * (SQR(WCA_part) - WCA_part + 0.25);
-			number S_part = SQR(SQR(r_mod - _rep_rcut));
-			number S = S_part / (_h_zausch_4 + S_part);
-			energy += WCA * S;
+		number force_over_r;
+		energy = _AO_energy(r_norm, (update_forces) ? &force_over_r : NULL);
 
-			if(update_forces) {
-				number WCA_der = 24. * (WCA_part - 2 * SQR(WCA_part)) / r_mod;
-				number S_der = (1 - S) * (4 * CUB(r_mod - _rep_rcut)) / (_h_zausch_4 + S_part);
-				number force = -(WCA_der * S + WCA * S_der);
-				p->force -= _computed_r * (force / r_mod);
-				q->force += _computed_r * (force / r_mod);
-			}
+		if(update_forces) {
+			p->force -= _computed_r * force_over_r;
+			q->force += _computed_r * force_over_r;
 		}
+	}
 
-		number r_rescaled = r_mod / _sigma_colloid_polymer;
-		energy += -_attraction_strength * (1. - 3. / 4. * r_rescaled + CUB(r_rescaled) / 16.);
+	return energy;
+}
 
-		if(update_forces) {
-			number force = -_attraction_strength * (3. / 4. - 3. * SQR(r_rescaled) / 16.) / _sigma_colloid_polymer;
-			p->force -= _computed_r * (force / r_mod);
-			q->force += _computed_r * (force / r_mod);
+number AOInteraction::nonbonded_block(BaseParticle *p, const std::vector<BaseParticle *> &neighs, bool update_forces) {
+	number energy = 0;
+	// the force acting on p is accumulated locally and applied only once
+	LR_vector p_force;
+
+	for(auto q : neighs) {
+		LR_vector r = this->_box->min_image(p->pos, q->pos);
+		number r_norm = r.norm();
+		if(r_norm < this->_sqr_rcut) {
+			number force_over_r;
+			energy += _AO_energy(r_norm, (update_forces) ? &force_over_r : NULL);
+
+			if(update_forces) {
+				p_force -= r * force_over_r;
+				q->force += r * force_over_r;
+			}
 		}
 	}
 
+	if(update_forces) {
+		p->force += p_force;
+	}
+
 	return energy;
 }
 
@@ -110,3 +147,13 @@ void AOInteraction::check_input_sanity(std::vector<BaseParticle *> &particles) {
 extern "C" AOInteraction *make_AOInteraction() {
 	return new AOInteraction();
 }
+
+extern "C" void register_kernels_AOInteraction(BaseInteraction *interaction) {
+	AOInteraction *AO = static_cast<AOInteraction *>(interaction);
+	interaction->register_neighbour_block_kernel([AO](BaseParticle *p, const std::vector<BaseParticle *> &neighs, bool update_forces) {
+		return AO->nonbonded_block(p, neighs, update_forces);
+	});
+	interaction->register_energy_block_kernel([AO](BaseParticle *p, const std::vector<BaseParticle *> &neighs) {
+		return AO->nonbonded_block(p, neighs, false);
+	});
+}
@@ -18,6 +18,13 @@ protected:
 	number _h_zausch_4;
 	number _rep_rcut, _rep_rcut_sqr;
 
+	/**
+	 * @brief Returns the energy of a pair of particles at squared distance r_norm (which should be smaller than the squared cut-off).
+	 *
+	 * If force_over_r is not NULL, it is set to the modulus of the force divided by the distance.
+	 */
+	number _AO_energy(number r_norm, number *force_over_r);
+
 public:
 	enum {
 		AO = 4
@@ -37,8 +44,11 @@ public:
 	virtual number pair_interaction_nonbonded(BaseParticle *p, BaseParticle *q, bool compute_r = true, bool update_forces = false);
 
 	virtual void check_input_sanity(std::vector<BaseParticle *> &particles);
+
+	number nonbonded_block(BaseParticle *p, const std::vector<BaseParticle *> &neighs, bool update_forces);
 };
 
 extern "C" AOInteraction *make_AOInteraction();
+extern "C" void register_kernels_AOInteraction(BaseInteraction *interaction);
 
 #endif /* AOINTERACTION_H_ */
@@ -59,6 +59,8 @@ void OxpyManager::update_temperature(number new_T) {
 }
 
 void OxpyManager::print_configuration(bool also_last) {
+	// the particles may have been moved from Python since the molecules computed their properties
+	_backend->invalidate_molecules();
 	// prints the trajectory configuration
 	_backend->print_conf();
 	// prints the last configuration
@@ -85,10 +87,303 @@ void OxpyManager::update_CPU_data_structures() {
 	_backend->apply_simulation_data_changes();
 }
 
-void OxpyManager::run(llint steps, bool print_output) {
+void OxpyManager::apply_changes_to_simulation_data() {
+	// positions and orientations may have been changed through a view, so we update everything that depends on them
+	if(_configuration_exposed) {
+		for(auto p : CONFIG_INFO->particles()) {
+			if(_orientations_exposed) {
+				p->orientationT = p->orientation.get_transpose();
+			}
+			p->set_positions();
+			CONFIG_INFO->lists->single_update(p);
+		}
+		CONFIG_INFO->lists->global_update(true);
+		_backend->invalidate_molecules();
+		_backend->recompute_cached_quantities();
+	}
 	_backend->apply_changes_to_simulation_data();
+}
+
+std::shared_ptr<ParticleFieldView> OxpyManager::particle_view(std::string field) {
+	auto view_field = ParticleFieldView::field_from_string(field);
+	auto view = std::make_shared<ParticleFieldView>(CONFIG_INFO->particles(), view_field);
+	if(view->is_zero_copy()) {
+		if(view_field == ParticleFieldView::ORIENTATIONS) {
+			_orientations_exposed = true;
+			_configuration_exposed = true;
+		}
+		else if(view_field == ParticleFieldView::POSITIONS) {
+			_configuration_exposed = true;
+		}
+	}
+
+	return view;
+}
+
+/**
+ * Stores the value of the interaction's is_infinite flag, and restores it when it goes out of scope. The flag is set by
+ * overlapping pairs and makes get_system_energy() return straight away, so it has to be cleared before evaluating
+ * each pair or configuration
+ */
+struct InfiniteFlagBackup {
+	InfiniteFlagBackup(BaseInteraction *interaction) :
+					interaction(interaction),
+					was_infinite(interaction->get_is_infinite()) {
+
+	}
+
+	~InfiniteFlagBackup() {
+		interaction->set_is_infinite(was_infinite);
+	}
+
+	void clear() {
+		interaction->set_is_infinite(false);
+	}
+
+	BaseInteraction *interaction;
+	bool was_infinite;
+};
+
+py::array_t<number> OxpyManager::pair_energies(py::array_t<int, py::array::c_style | py::array::forcecast> pairs, bool split) {
+	if(pairs.ndim() != 2 || pairs.shape(1) != 2) {
+		throw oxDNAException("pair_energies expects a Mx2 array of particle indexes");
+	}
+
+	auto &particles = CONFIG_INFO->particles();
+	BaseInteraction *interaction = CONFIG_INFO->interaction;
+	int N = particles.size();
+	int M = pairs.shape(0);
+	const int *idxs = pairs.data();
+	for(int i = 0; i < 2 * M; i++) {
+		if(idxs[i] < 0 || idxs[i] >= N) {
+			throw oxDNAException("pair_energies: invalid particle index %d", idxs[i]);
+		}
+	}
+
+	std::vector<int> terms = interaction->get_term_ids();
+	int n_cols = (split) ? terms.size() : 1;
+	std::vector<py::ssize_t> shape = {M};
+	if(split) {
+		shape.push_back(n_cols);
+	}
+	py::array_t<number> result(shape);
+	number *res = result.mutable_data();
+
+	{
+		py::gil_scoped_release release;
+		InfiniteFlagBackup infinite_flag(interaction);
+		interaction->begin_energy_computation();
+		for(int i = 0; i < M; i++) {
+			infinite_flag.clear();
+			BaseParticle *p = particles[idxs[2 * i]];
+			BaseParticle *q = particles[idxs[2 * i + 1]];
+			if(split) {
+				for(int t = 0; t < n_cols; t++) {
+					res[i * n_cols + t] = interaction->pair_interaction_term(terms[t], p, q);
+				}
+			}
+			else {
+				res[i] = interaction->pair_interaction(p, q);
+			}
+		}
+	}
+
+	return result;
+}
+
+int OxpyManager::_check_configuration_arrays(py::array_t<number, py::array::c_style | py::array::forcecast> &positions, py::object &orientations, py::array_t<number, py::array::c_style | py::array::forcecast> &orientations_array) {
+	int N = CONFIG_INFO->N();
+	if(positions.ndim() != 3 || positions.shape(1) != N || positions.shape(2) != 3) {
+		throw oxDNAException("The positions should be passed as a MxNx3 array, with N = %d being the number of particles", N);
+	}
+	int M = positions.shape(0);
+
+	if(!orientations.is_none()) {
+		orientations_array = py::array_t<number, py::array::c_style | py::array::forcecast>::ensure(orientations);
+		if(!orientations_array || orientations_array.ndim() != 4 || orientations_array.shape(0) != M || orientations_array.shape(1) != N || orientations_array.shape(2) != 3 || orientations_array.shape(3) != 3) {
+			throw oxDNAException("The orientations should be passed as a MxNx3x3 array, with M = %d being the number of configurations and N = %d the number of particles", M, N);
+		}
+	}
+
+	return M;
+}
+
+void OxpyManager::_load_configuration(int idx, const number *positions, const number *orientations) {
+	auto &particles = CONFIG_INFO->particles();
+	int N = particles.size();
+	for(int i = 0; i < N; i++) {
+		BaseParticle *p = particles[i];
+		const number *pos = positions + (idx * N + i) * 3;
+		p->pos = LR_vector(pos[0], pos[1], pos[2]);
+		if(orientations != nullptr) {
+			const number *o = orientations + (idx * N + i) * 9;
+			p->orientation = LR_matrix(o[0], o[1], o[2], o[3], o[4], o[5], o[6], o[7], o[8]);
+			p->orientationT = p->orientation.get_transpose();
+		}
+		p->set_positions();
+		CONFIG_INFO->lists->single_update(p);
+	}
+	CONFIG_INFO->lists->global_update(true);
+}
+
+/**
+ * Stores the state of the particles that is changed by the configuration_* methods, and restores it when it goes out of scope
+ */
+struct ConfigurationBackup {
+	struct ParticleState {
+		LR_vector pos, force, torque;
+		LR_matrix orientation, orientationT;
+	};
+
+	ConfigurationBackup() {
+		for(auto p : CONFIG_INFO->particles()) {
+			states.push_back({p->pos, p->force, p->torque, p->orientation, p->orientationT});
+		}
+	}
+
+	~ConfigurationBackup() {
+		auto &particles = CONFIG_INFO->particles();
+		for(uint i = 0; i < particles.size(); i++) {
+			BaseParticle *p = particles[i];
+			p->pos = states[i].pos;
+			p->force = states[i].force;
+			p->torque = states[i].torque;
+			p->orientation = states[i].orientation;
+			p->orientationT = states[i].orientationT;
+			p->set_positions();
+			CONFIG_INFO->lists->single_update(p);
+		}
+		CONFIG_INFO->lists->global_update(true);
+	}
+
+	std::vector<ParticleState> states;
+};
+
+py::array_t<number> OxpyManager::configuration_energies(py::array_t<number, py::array::c_style | py::array::forcecast> positions, py::object orientations, bool split) {
+	py::array_t<number, py::array::c_style | py::array::forcecast> orientations_array;
+	int M = _check_configuration_arrays(positions, orientations, orientations_array);
+	const number *poss = positions.data();
+	const number *orients = (orientations.is_none()) ? nullptr : orientations_array.data();
+
+	BaseInteraction *interaction = CONFIG_INFO->interaction;
+	std::vector<int> terms = interaction->get_term_ids();
+	int n_cols = (split) ? terms.size() : 1;
+	std::vector<py::ssize_t> shape = {M};
+	if(split) {
+		shape.push_back(n_cols);
+	}
+	py::array_t<number> result(shape);
+	number *res = result.mutable_data();
+
+	{
+		py::gil_scoped_release release;
+		ConfigurationBackup backup;
+		InfiniteFlagBackup infinite_flag(interaction);
+		for(int c = 0; c < M; c++) {
+			_load_configuration(c, poss, orients);
+			infinite_flag.clear();
+			if(split) {
+				auto energies = interaction->get_system_energy_split(CONFIG_INFO->particles(), CONFIG_INFO->lists);
+				for(int t = 0; t < n_cols; t++) {
+					res[c * n_cols + t] = energies[terms[t]];
+				}
+			}
+			else {
+				res[c] = interaction->get_system_energy(CONFIG_INFO->particles(), CONFIG_INFO->lists);
+			}
+		}
+	}
+
+	return result;
+}
+
+py::tuple OxpyManager::configuration_forces(py::array_t<number, py::array::c_style | py::array::forcecast> positions, py::object orientations) {
+	py::array_t<number, py::array::c_style | py::array::forcecast> orientations_array;
+	int M = _check_configuration_arrays(positions, orientations, orientations_array);
+	const number *poss = positions.data();
+	const number *orients = (orientations.is_none()) ? nullptr : orientations_array.data();
+
+	auto &particles = CONFIG_INFO->particles();
+	BaseInteraction *interaction = CONFIG_INFO->interaction;
+	int N = particles.size();
+	py::array_t<number> energies(std::vector<py::ssize_t>{M});
+	py::array_t<number> forces({M, N, 3});
+	py::array_t<number> torques({M, N, 3});
+	number *en = energies.mutable_data();
+	number *fs = forces.mutable_data();
+	number *ts = torques.mutable_data();
+
+	{
+		py::gil_scoped_release release;
+		ConfigurationBackup backup;
+		InfiniteFlagBackup infinite_flag(interaction);
+		for(int c = 0; c < M; c++) {
+			_load_configuration(c, poss, orients);
+			infinite_flag.clear();
+
+			for(auto p : particles) {
+				p->torque = LR_vector((number) 0., (number) 0., (number) 0.);
+				p->set_initial_forces(CONFIG_INFO->curr_step, CONFIG_INFO->box);
+			}
+
+			// the neighbour lists of MC simulations contain each pair twice, so we use the list of unique pairs
+			interaction->begin_energy_and_force_computation();
+			number U = (number) 0.;
+			for(auto p : particles) {
+				for(auto &pair : p->affected) {
+					if(pair.first == p) {
+						U += interaction->pair_interaction_bonded(pair.first, pair.second, true, true);
+					}
+				}
+			}
+			for(auto &pair : CONFIG_INFO->lists->get_potential_interactions()) {
+				U += interaction->pair_interaction_nonbonded(pair.first, pair.second, true, true);
+			}
+
+			en[c] = U;
+			for(int i = 0; i < N; i++) {
+				BaseParticle *p = particles[i];
+				number *f = fs + (c * N + i) * 3;
+				number *t = ts + (c * N + i) * 3;
+				f[0] = p->force.x;
+				f[1] = p->force.y;
+				f[2] = p->force.z;
+				t[0] = p->torque.x;
+				t[1] = p->torque.y;
+				t[2] = p->torque.z;
+			}
+		}
+	}
+
+	return py::make_tuple(energies, forces, torques);
+}
+
+void OxpyManager::add_callback(std::function<void()> callback, llint every) {
+	if(every < 1) {
+		throw oxDNAException("The number of steps between two invocations of a callback should be larger than 0 (got %lld)", every);
+	}
+	_callbacks.emplace_back(every, callback);
+}
+
+void OxpyManager::clear_callbacks() {
+	_callbacks.clear();
+}
+
+void OxpyManager::run(llint steps, bool print_output) {
+	apply_changes_to_simulation_data();
+
+	// the simulation runs without holding the GIL, which is acquired only when Python code has to be invoked
+	// (callbacks, Python observables and forces) and, every _check_signals_every steps, to handle signals such as SIGINT
+	py::gil_scoped_release release;
 
 	for(llint i = 0; i < steps && !SimManager::stop; i++, _steps_run++) {
+		if(i > 0 && i % _check_signals_every == 0) {
+			py::gil_scoped_acquire acquire;
+			if(PyErr_CheckSignals() != 0) {
+				throw py::error_already_set();
+			}
+		}
+
 		if(_backend->current_step() == _time_scale_manager.next_step) {
 			if(print_output && i > 0) {
 				_backend->print_conf();
@@ -104,8 +399,28 @@ void OxpyManager::run(llint steps, bool print_output) {
 		if(print_output) {
 			_backend->print_observables();
 		}
+		if(_metrics->is_due(_backend->current_step())) {
+			_update_metrics();
+		}
+		if(_annealing->is_due(_backend->current_step())) {
+			_anneal();
+		}
+
+		bool called_back = false;
+		for(auto &callback : _callbacks) {
+			if(_backend->current_step() % callback.first == 0) {
+				// the wrapper generated by pybind11 acquires the GIL before calling the Python function
+				callback.second();
+				called_back = true;
+			}
+		}
+		// callbacks may have changed the configuration through a view
+		if(called_back && _configuration_exposed) {
+			apply_changes_to_simulation_data();
+		}
 
 		_backend->sim_step();
+		CONFIG_INFO->flush_events();
 		_backend->increment_current_step();
 	}
 
@@ -224,9 +539,105 @@ input: :class:`InputFile`
 		It is automatically invoked by meth:`run`, and therefore it makes sense to call it only in specific cases (*e.g.* to access simulation data from callbacks).
 	)pbdoc");
 
+	manager.def("apply_changes_to_simulation_data", &OxpyManager::apply_changes_to_simulation_data, R"pbdoc(
+		Make the simulation aware of the changes done to the particles' data (for instance through the views returned by :meth:`particle_view`).
+
+		If positions or orientations have been exposed through a view, the positions of the interaction centres, the neighbour lists,
+		the properties of the molecules and the quantities stored by the backend (e.g. the energies of Monte Carlo simulations
+		or the forces of molecular dynamics simulations) are updated. On CUDA simulations the data is then copied to the GPU.
+		This method is automatically invoked by :meth:`run`, both at the beginning and after each invocation of the callbacks.
+	)pbdoc");
+
+	manager.def("particle_view", &OxpyManager::particle_view, pybind11::arg("field"), py::keep_alive<0, 1>(), R"pbdoc(
+		Return a :class:`ParticleFieldView` of the given per-particle quantity that can be converted to a numpy array. 
+
+		If the particles are stored contiguously in memory the view is writable and does not copy any data, and changes made through it
+		are reflected in the simulation (on CUDA simulations, after calling :meth:`apply_changes_to_simulation_data` or :meth:`run`).
+
+		Parameters
+		----------
+			field : str
+				The quantity to be viewed: "positions", "velocities", "angular_momenta", "forces", "torques" or "orientations".
+
+		Returns
+		-------
+			:class:`ParticleFieldView`
+				The view.
+	)pbdoc");
+
+	manager.def("pair_energies", &OxpyManager::pair_energies, pybind11::arg("pairs"), pybind11::arg("split") = false, R"pbdoc(
+		Compute the interaction energy of many pairs of particles with a single call.
+
+		Parameters
+		----------
+			pairs : numpy.ndarray
+				A Mx2 array of particle indexes.
+			split : bool
+				If True, the energy of each pair is split into its contributions (one column per energy term), otherwise (the default value)
+				only the total pair energies are returned.
+
+		Returns
+		-------
+			numpy.ndarray
+				An array of shape (M,) or, if `split` is True, of shape (M, number of terms) containing the pair energies.
+	)pbdoc");
+
+	manager.def("configuration_energies", &OxpyManager::configuration_energies, pybind11::arg("positions"), pybind11::arg("orientations") = py::none(), pybind11::arg("split") = false, R"pbdoc(
+		Compute the potential energy of many configurations of the system with a single call. The configurations are evaluated
+		one after the other using the simulation's interaction, box and lists. The state of the simulation is left unchanged.
+
+		Parameters
+		----------
+			positions : numpy.ndarray
+				A MxNx3 array storing the positions of the N particles in each of the M configurations.
+			orientations : numpy.ndarray
+				An optional MxNx3x3 array storing the orientation matrices of the particles. If not given, the current orientations are used.
+			split : bool
+				If True, the energy of each configuration is split into its contributions (one column per energy term).
+
+		Returns
+		-------
+			numpy.ndarray
+				An array of shape (M,) or, if `split` is True, of shape (M, number of terms) containing the (total, not per-particle) energies.
+	)pbdoc");
+
+	manager.def("configuration_forces", &OxpyManager::configuration_forces, pybind11::arg("positions"), pybind11::arg("orientations") = py::none(), R"pbdoc(
+		Compute the potential energy and the forces and torques acting on the particles for many configurations of the system with a single call.
+		See :meth:`configuration_energies` for the meaning of the parameters. The state of the simulation is left unchanged.
+
+		Returns
+		-------
+			tuple
+				A tuple containing the energies (shape (M,)), the forces (shape (M, N, 3)) and the torques (shape (M, N, 3), 
+				expressed in the particles' reference frames). The forces include the contribution of the external forces,
+				while the energies contain only the interaction energy, as in :meth:`configuration_energies`.
+	)pbdoc");
+
+	manager.def("add_callback", &OxpyManager::add_callback, pybind11::arg("callback"), pybind11::arg("every"), R"pbdoc(
+		Register a callable that will be invoked by :meth:`run` every `every` time steps.
+
+		Since :meth:`run` releases the GIL while running the simulation, the interpreter is involved only when callbacks 
+		(or Python observables and forces) have to be invoked. Note that callbacks are invoked before updating the CPU data 
+		structures, so on CUDA simulations they may need to call :meth:`update_CPU_data_structures` before accessing the particles.
+
+		Parameters
+		----------
+			callback : callable
+				A callable that takes no parameters.
+			every : int
+				The number of time steps between two consecutive invocations of the callback.
+	)pbdoc");
+
+	manager.def("clear_callbacks", &OxpyManager::clear_callbacks, R"pbdoc(
+		Remove all the callbacks registered with :meth:`add_callback`.
+	)pbdoc");
+
 	manager.def("run", &OxpyManager::run, pybind11::arg("steps"), pybind11::arg("print_output") = true, R"pbdoc(
 		Run the simulation for the given number of steps. The second argument controls whether the simulations output (configurations and observables) should be printed or not.
 
+		The GIL is released while the simulation runs, and reacquired only to invoke Python code (callbacks registered with :meth:`add_callback`, 
+		Python observables and forces) and, periodically, to handle signals (*e.g.* to stop the simulation with Ctrl+C).
+
 		Parameters
 		----------
 			steps : int
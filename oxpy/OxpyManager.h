@@ -9,11 +9,29 @@
 #define OXPY_OXPYMANAGER_H_
 
 #include <Managers/SimManager.h>
+#include <Utilities/FlattenedConfigInfo.h>
 #include "python_defs.h"
 
+#include <pybind11/numpy.h>
+
 class OxpyManager: public SimManager {
 private:
 	llint _steps_run = 0;
+	static const llint _check_signals_every = 1000;
+	bool _orientations_exposed = false;
+	/// true if positions or orientations have been exposed through zero-copy views, and hence may be changed from Python at any time
+	bool _configuration_exposed = false;
+	/// (interval, callback) pairs of the Python callbacks that should be invoked while running the simulation
+	std::vector<std::pair<llint, std::function<void()>>> _callbacks;
+
+	/**
+	 * Checks the shapes of the arrays passed to the configuration_* methods, and returns the number of configurations
+	 */
+	int _check_configuration_arrays(py::array_t<number, py::array::c_style | py::array::forcecast> &positions, py::object &orientations, py::array_t<number, py::array::c_style | py::array::forcecast> &orientations_array);
+	/**
+	 * Loads the idx-th configuration into the particles and updates the lists
+	 */
+	void _load_configuration(int idx, const number *positions, const number *orientations);
 public:
 	OxpyManager(std::string input_filename);
 	OxpyManager(input_file input);
@@ -26,6 +44,15 @@ public:
 	void add_output(std::string filename, llint print_every, std::vector<ObservablePtr> observables);
 	void remove_output(std::string filename);
 	void update_CPU_data_structures();
+	void apply_changes_to_simulation_data();
+	std::shared_ptr<ParticleFieldView> particle_view(std::string field);
+
+	py::array_t<number> pair_energies(py::array_t<int, py::array::c_style | py::array::forcecast> pairs, bool split);
+	py::array_t<number> configuration_energies(py::array_t<number, py::array::c_style | py::array::forcecast> positions, py::object orientations, bool split);
+	py::tuple configuration_forces(py::array_t<number, py::array::c_style | py::array::forcecast> positions, py::object orientations);
+
+	void add_callback(std::function<void()> callback, llint every);
+	void clear_callbacks();
 
 	void run(llint steps, bool print_output=true);
 	llint steps_run() {
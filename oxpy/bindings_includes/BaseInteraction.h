@@ -201,6 +201,16 @@ void export_BaseInteraction(py::module &m) {
 	interaction.def("begin_energy_computation", &BaseInteraction::begin_energy_computation, R"pbdoc(
 		Signals the interaction that an energy (or force) computation is about to begin.
     )pbdoc");
+
+	interaction.def("get_parameter_derivatives", &BaseInteraction::get_parameter_derivatives, R"pbdoc(
+		Return the derivatives of the potential energy with respect to the model parameters, accumulated since the last call to :meth:`begin_energy_computation`. 
+		Only DNA2 and RNA2 interactions support this feature, which should be enabled by setting `compute_parameter_derivatives = true` in the input file.
+
+		Returns
+		-------
+		dict
+			A dictionary mapping the name of each parameter to the derivative of the energy with respect to it. Empty if the feature is not supported or not enabled.
+    )pbdoc");
 }
 
 #endif /* OXPY_BINDINGS_INCLUDES_BASEINTERACTION_H_ */
@@ -16,7 +16,30 @@ void export_ConfigInfo(py::module &m) {
 		This singleton object stores all the details of the simulation (particles, neighbour lists, input file, interaction, external forces) 
 	)pbdoc");
 
-	conf_info.def("notify", &ConfigInfo::notify, py::arg("event"), R"pbdoc(
+	conf_info.def("register_event", &ConfigInfo::register_event, py::arg("event"), R"pbdoc(
+		Return the integer handle associated to the given event, registering the event if required. 
+
+		Parameters
+		----------
+		event: str
+			The name of the event.
+
+		Returns
+		-------
+		int
+			The handle of the event.
+	)pbdoc");
+
+	conf_info.def("notify", py::overload_cast<ConfigInfo::EventHandle>(&ConfigInfo::notify), py::arg("event"), R"pbdoc(
+		Notify the triggering of an event. Any callback associated to the event will be invoked.
+
+		Parameters
+		----------
+		event: int
+			The handle of the triggered event.
+	)pbdoc");
+
+	conf_info.def("notify", py::overload_cast<const std::string &>(&ConfigInfo::notify), py::arg("event"), R"pbdoc(
 		Notify the triggering of an event. Any callback associated to the event will be invoked.
 
 		Parameters
@@ -25,7 +48,34 @@ void export_ConfigInfo(py::module &m) {
 			The triggered event.
 	)pbdoc");
 
-	conf_info.def("subscribe", &ConfigInfo::subscribe, py::arg("event"), py::arg("callback"), R"pbdoc(
+	conf_info.def("notify_deferred", &ConfigInfo::notify_deferred, py::arg("event"), R"pbdoc(
+		Notify the triggering of an event. The callbacks associated to the event will be invoked only once, at the end of the current simulation step.
+
+		Parameters
+		----------
+		event: int
+			The handle of the triggered event.
+	)pbdoc");
+
+	conf_info.def("subscribe", [](ConfigInfo &ci, ConfigInfo::EventHandle event, std::function<void()> callback) {
+		ci.subscribe(event, callback);
+	}, py::arg("event"), py::arg("callback"), R"pbdoc(
+		Assign a callback to the given event. 
+
+		The callback will be invoked every time the event is triggered.
+
+		Parameters
+		----------
+		event: int
+			The handle of the event associated to the callback.
+		callback: callable
+			A callable that takes no parameters.
+
+	)pbdoc");
+
+	conf_info.def("subscribe", [](ConfigInfo &ci, const std::string &event, std::function<void()> callback) {
+		ci.subscribe(event, callback);
+	}, py::arg("event"), py::arg("callback"), R"pbdoc(
 		Assign a callback to the given event. 
 
 		The callback will be invoked every time the event is triggered.
@@ -54,6 +54,42 @@ void export_FlattenedConfigInfo(py::module &m) {
 	conf_info.def_readonly("a1s", &FlattenedConfigInfo::a1s, R"pbdoc(Particle a1 orientation vectors)pbdoc");
 	conf_info.def_readonly("a3s", &FlattenedConfigInfo::a3s, R"pbdoc(Particle a3 orientation vectors)pbdoc");
 	conf_info.def_readonly("types", &FlattenedConfigInfo::types, R"pbdoc(Particle types)pbdoc");
+
+	py::class_<ParticleFieldView, std::shared_ptr<ParticleFieldView>> field_view(m, "ParticleFieldView", py::buffer_protocol(), R"pbdoc(
+        A view of a per-particle quantity (positions, velocities, angular momenta, forces, torques or orientations) as a Nx3 
+        (or Nx3x3 for orientations) matrix, obtained through :meth:`OxpyManager.particle_view`.
+
+        If the particles are stored contiguously in memory (which is the default, see the `particle_arena` option), the view 
+        does not copy any data and it is writable: changes made to the numpy array are directly applied to the particles::
+
+            poss = np.array(manager.particle_view("positions"), copy=False)
+            poss += [0., 0., 1.] # shift all the particles along z
+
+        Otherwise the view stores a read-only copy of the data (see :attr:`is_zero_copy`).
+	)pbdoc");
+
+	field_view.def_buffer([](ParticleFieldView &view) -> py::buffer_info {
+		std::vector<py::ssize_t> shape = {view.rows(), view.cols()};
+		std::vector<py::ssize_t> strides = {view.row_stride(), sizeof(number)};
+		if(view.cols() == 9) {
+			shape = {view.rows(), 3, 3};
+			strides = {view.row_stride(), 3 * sizeof(number), sizeof(number)};
+		}
+
+		return py::buffer_info(
+				view.data(),
+				sizeof(number),
+				py::format_descriptor<number>::format(),
+				shape.size(),
+				shape,
+				strides,
+				!view.is_zero_copy()
+		);
+	});
+
+	field_view.def_property_readonly("is_zero_copy", &ParticleFieldView::is_zero_copy, R"pbdoc(
+        True if the view points directly to the particles' data, False if it stores a (read-only) copy.
+	)pbdoc");
 }
 
 #endif /* OXPY_BINDINGS_INCLUDES_FLATTENEDCONFIGINFO_H_ */
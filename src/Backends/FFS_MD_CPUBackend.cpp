@@ -15,6 +15,7 @@
 #include "../Interactions/DNA2Interaction.h"
 #include "../Interactions/RNAInteraction2.h"
 #include "../Managers/SimManager.h"
+#include "../Boxes/BoxDispatch.h"
 
 using namespace std;
 
@@ -193,7 +194,6 @@ bool parsed_condition::eval_condition(OrderParameters *op) {
 
 FFS_MD_CPUBackend::FFS_MD_CPUBackend() :
 				MD_CPUBackend() {
-	_sqr_rcut = -1;
 }
 
 FFS_MD_CPUBackend::~FFS_MD_CPUBackend() {
@@ -206,17 +206,12 @@ void FFS_MD_CPUBackend::get_settings(input_file &inp) {
 	getInputString(&inp, "ffs_file", _ffs_file, 1);
 }
 
-number FFS_MD_CPUBackend::pair_interaction_nonbonded_DNA_with_op(BaseParticle *p, BaseParticle *q, bool compute_r, bool update_forces) {
-	LR_vector computed_r;
-	if(compute_r) {
-		computed_r = _box->min_image(p->pos, q->pos);
-	}
-
-	if(computed_r.norm() >= _sqr_rcut) {
+number FFS_MD_CPUBackend::pair_interaction_nonbonded_DNA_with_op(BaseParticle *p, BaseParticle *q, LR_vector r, bool update_forces) {
+	if(r.norm() >= _sqr_rcut) {
 		return (number) 0.f;
 	}
 
-	_interaction->set_computed_r(computed_r);
+	_interaction->set_computed_r(r);
 	number energy = _interaction->pair_interaction_term(DNAInteraction::HYDROGEN_BONDING, p, q, false, update_forces);
 
 	if(energy <= MAX_BOND_CUTOFF) {
@@ -245,6 +240,13 @@ void FFS_MD_CPUBackend::_ffs_compute_forces(void) {
 	_interaction->begin_energy_computation();
 
 	_U = (number) 0;
+	dispatch_box(_box.get(), [this](auto box) {
+		this->_ffs_compute_forces(box);
+	});
+}
+
+template<typename box_type>
+void FFS_MD_CPUBackend::_ffs_compute_forces(const box_type *box) {
 	for(auto p: _particles) {
 		typename vector<ParticlePair>::iterator it = p->affected.begin();
 		for(; it != p->affected.end(); it++) {
@@ -256,7 +258,7 @@ void FFS_MD_CPUBackend::_ffs_compute_forces(void) {
 		std::vector<BaseParticle *> neighs = _lists->get_neigh_list(p);
 		for(unsigned int n = 0; n < neighs.size(); n++) {
 			BaseParticle *q = neighs[n];
-			_U += pair_interaction_nonbonded_DNA_with_op(p, q, true, true);
+			_U += pair_interaction_nonbonded_DNA_with_op(p, q, box->min_image_direct(p->pos, q->pos), true);
 		}
 	}
 }
@@ -367,7 +369,9 @@ char * FFS_MD_CPUBackend::get_op_state_str(void) {
 }
 
 void FFS_MD_CPUBackend::print_observables() {
-	_backend_info = get_op_state_str();
+	if(_outputs_due()) {
+		_backend_info = get_op_state_str();
+	}
 	MDBackend::print_observables();
 }
 
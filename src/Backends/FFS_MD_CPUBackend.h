@@ -116,9 +116,14 @@ protected:
 	std::string _ffs_file;
 	char _state_str[2048];
 
-	number _sqr_rcut;
 	void _ffs_compute_forces(void);
-	number pair_interaction_nonbonded_DNA_with_op(BaseParticle *p, BaseParticle *q, bool compute_r, bool update_forces = false);
+
+	/**
+	 * @brief Computes the forces, computing the distances with the box's concrete type. Called by _ffs_compute_forces().
+	 */
+	template<typename box_type>
+	void _ffs_compute_forces(const box_type *box);
+	number pair_interaction_nonbonded_DNA_with_op(BaseParticle *p, BaseParticle *q, LR_vector r, bool update_forces = false);
 
 public:
 	FFS_MD_CPUBackend();
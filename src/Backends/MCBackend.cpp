@@ -114,14 +114,28 @@ void MCBackend::get_settings(input_file &inp) {
 	}
 }
 
-void MCBackend::print_observables() {
-	std::string tmpstr("");
+void MCBackend::get_metrics(std::vector<std::pair<std::string, number>> &metrics) {
+	SimBackend::get_metrics(metrics);
+
+	static const char *move_names[MC_MOVES] = { "translation", "rotation", "volume", "cluster_size" };
+
+	metrics.emplace_back("oxdna_potential_energy", _U / N());
 	for(int i = 0; i < _MC_moves; i++) {
-		number ratio = (_tries[i] > 0) ? _accepted[i] / (float) _tries[i] : 0;
-		//_backend_info += Utils::sformat("  %5.3lf", ratio);
-		tmpstr += Utils::sformat("  %5.3lf", ratio);
+		number ratio = (_tries[i] > 0) ? _accepted[i] / (number) _tries[i] : 0;
+		metrics.emplace_back(Utils::sformat("oxdna_acceptance_ratio{move=\"%s\"}", move_names[i]), ratio);
+	}
+}
+
+void MCBackend::print_observables() {
+	if(_outputs_due()) {
+		std::string tmpstr("");
+		for(int i = 0; i < _MC_moves; i++) {
+			number ratio = (_tries[i] > 0) ? _accepted[i] / (float) _tries[i] : 0;
+			//_backend_info += Utils::sformat("  %5.3lf", ratio);
+			tmpstr += Utils::sformat("  %5.3lf", ratio);
+		}
+		_backend_info.insert(0, tmpstr + "  ");
 	}
-	_backend_info.insert(0, tmpstr + "  ");
 
 	SimBackend::print_observables();
 }
@@ -64,6 +64,7 @@ public:
 	void get_settings(input_file &inp);
 
 	virtual void print_observables();
+	virtual void get_metrics(std::vector<std::pair<std::string, number>> &metrics);
 };
 
 #endif /* MCBACKEND_H_ */
@@ -21,7 +21,7 @@ BaseMove::BaseMove() :
 	_rej_fact = 1.001;
 	_acc_fact = 0.;
 
-	CONFIG_INFO->subscribe("T_updated", [this]() { this->_on_T_update(); });
+	CONFIG_INFO->subscribe(ConfigInfo::T_UPDATED, [this]() { this->_on_T_update(); });
 }
 
 BaseMove::~BaseMove() {
@@ -14,6 +14,7 @@
 #include "MCRot.h"
 #include "VolumeMove.h"
 #include "MoleculeVolumeMove.h"
+#include "TriclinicMove.h"
 #include "Pivot.h"
 #include "VMMC.h"
 #include "ShapeMove.h"
@@ -30,6 +31,7 @@ MovePtr MoveFactory::make_move(input_file &inp, input_file &sim_inp) {
 	else if(!move_type.compare("translation")) ret = std::make_shared<MCTras>();
 	else if(!move_type.compare("volume")) ret = std::make_shared<VolumeMove>();
 	else if(!move_type.compare("molecule_volume")) ret = std::make_shared<MoleculeVolumeMove>();
+	else if(!move_type.compare("triclinic")) ret = std::make_shared<TriclinicMove>();
 	else if(!move_type.compare("VMMC")) ret = std::make_shared<VMMC>();
 	else if(!move_type.compare("shape")) ret = std::make_shared<ShapeMove>();
 	else if(!move_type.compare("rotate_site")) ret = std::make_shared<RotateSite>();
@@ -111,7 +111,7 @@ void ShapeMove::apply (llint curr_step) {
 	if (this->_Info->interaction->get_is_infinite() == false && exp(- dE / this->_T) > drand48()) {
 		this->_accepted ++;
 		if (curr_step < this->_equilibration_steps && this->_adjust_moves) _delta *= this->_acc_fact;
-		CONFIG_INFO->notify(CONFIG_INFO->box->UPDATE_EVENT);
+		CONFIG_INFO->notify_deferred(ConfigInfo::BOX_UPDATED);
 	}
 	else {
 		//printf ("reject: dE = %g\n", dE);
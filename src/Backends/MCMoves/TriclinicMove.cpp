@@ -0,0 +1,144 @@
+/**
+ * @file    TriclinicMove.cpp
+ */
+
+#include "TriclinicMove.h"
+
+#include "../../Boxes/TriclinicBox.h"
+
+TriclinicMove::TriclinicMove() {
+	_P = 0.;
+	_delta = 0.;
+	_delta_tilt = -1.;
+	_box = nullptr;
+}
+
+TriclinicMove::~TriclinicMove() {
+
+}
+
+void TriclinicMove::init() {
+	BaseMove::init();
+	_pos_old.resize(_Info->N());
+
+	_box = dynamic_cast<TriclinicBox *>(_Info->box);
+	if(_box == nullptr) {
+		throw oxDNAException("(TriclinicMove.cpp) TriclinicMove requires 'box_type = triclinic'");
+	}
+
+	if(_restrict_to_type > 0) {
+		OX_LOG(Logger::LOG_WARNING, "(TriclinicMove.cpp) Cant use TriclinicMove with restrict_to_type. Ignoring");
+	}
+	OX_LOG(Logger::LOG_INFO, "(TriclinicMove.cpp) TriclinicMove initiated with T %g, delta %g, delta_tilt %g, prob: %g", _T, _delta, _delta_tilt, prob);
+}
+
+void TriclinicMove::get_settings(input_file &inp, input_file &sim_inp) {
+	BaseMove::get_settings(inp, sim_inp);
+
+	getInputNumber(&inp, "delta", &_delta, 1);
+	_delta_tilt = _delta;
+	getInputNumber(&inp, "delta_tilt", &_delta_tilt, 0);
+	getInputNumber(&inp, "prob", &prob, 0);
+	getInputNumber(&sim_inp, "P", &_P, 1);
+}
+
+void TriclinicMove::apply(llint curr_step) {
+	// we increase the attempted count
+	_attempted += 1;
+
+	std::vector<BaseParticle*> &particles = _Info->particles();
+	int N = _Info->N();
+
+	LR_vector old_sides = _box->box_sides();
+	LR_vector old_tilts = _box->tilts();
+	LR_vector sides = old_sides;
+	LR_vector tilts = old_tilts;
+
+	// perturb one of the six independent elements of the box matrix
+	int element = lrand48() % 6;
+	if(element < 3) {
+		sides[element] += _delta * (drand48() - (number) 0.5);
+	}
+	else {
+		tilts[element - 3] += _delta_tilt * (drand48() - (number) 0.5);
+	}
+
+	bool reject = !TriclinicBox::is_valid(sides.x, sides.y, sides.z, tilts.x, tilts.y, tilts.z);
+
+	number oldE = (number) 0.f;
+	number oldV = _box->V();
+	number dE = (number) 0.f;
+	number V = oldV;
+	LR_matrix old_inverse = _box->inverse_box_matrix();
+	if(!reject) {
+		if(_compute_energy_before) {
+			oldE = _Info->interaction->get_system_energy(_Info->particles(), _Info->lists);
+		}
+
+		_box->init(sides.x, sides.y, sides.z, tilts.x, tilts.y, tilts.z);
+		V = _box->V();
+
+		// the minimum image convention breaks down if the box gets too thin
+		LR_vector widths = _box->perpendicular_widths();
+		number min_width = 2. * _Info->interaction->get_rcut();
+		if(widths.x < min_width || widths.y < min_width || widths.z < min_width) {
+			_box->init(old_sides.x, old_sides.y, old_sides.z, old_tilts.x, old_tilts.y, old_tilts.z);
+			reject = true;
+		}
+	}
+
+	if(!reject) {
+		// the particles keep their fractional coordinates
+		LR_matrix transform = _box->box_matrix() * old_inverse;
+		number dExt = (number) 0.f;
+		for(int k = 0; k < N; k++) {
+			BaseParticle *p = particles[k];
+			dExt -= p->ext_potential;
+			_pos_old[k] = p->pos;
+			p->pos = transform * p->pos;
+			p->set_ext_potential(curr_step, _Info->box);
+			dExt += p->ext_potential;
+		}
+
+		// this bit has to come after the update of particles' positions
+		if(!_Info->lists->is_updated()) {
+			_Info->lists->global_update();
+		}
+
+		number newE = _Info->interaction->get_system_energy(_Info->particles(), _Info->lists);
+		dE = newE - oldE + dExt;
+	}
+
+	number dV = V - oldV;
+	if(!reject && _Info->interaction->get_is_infinite() == false && exp(-(dE + _P * dV - N * _T * log(V / oldV)) / _T) > drand48()) {
+		_accepted++;
+		if(curr_step < _equilibration_steps && _adjust_moves) {
+			_delta *= _acc_fact;
+			_delta_tilt *= _acc_fact;
+		}
+		CONFIG_INFO->notify_deferred(ConfigInfo::BOX_UPDATED);
+	}
+	else {
+		if(!reject) {
+			for(int k = 0; k < N; k++) {
+				BaseParticle *p = particles[k];
+				p->pos = _pos_old[k];
+				p->set_ext_potential(curr_step, _Info->box);
+			}
+			_Info->interaction->set_is_infinite(false);
+			_box->init(old_sides.x, old_sides.y, old_sides.z, old_tilts.x, old_tilts.y, old_tilts.z);
+			if(!_Info->lists->is_updated()) {
+				_Info->lists->global_update();
+			}
+		}
+		if(curr_step < _equilibration_steps && _adjust_moves) {
+			_delta /= _rej_fact;
+			_delta_tilt /= _rej_fact;
+		}
+	}
+}
+
+void TriclinicMove::log_parameters() {
+	BaseMove::log_parameters();
+	OX_LOG(Logger::LOG_INFO, "\tdelta %g, delta_tilt %g", _delta, _delta_tilt);
+}
@@ -0,0 +1,44 @@
+/**
+ * @file    TriclinicMove.h
+ */
+
+#ifndef TRICLINIC_MOVE_H_
+#define TRICLINIC_MOVE_H_
+
+#include "BaseMove.h"
+
+class TriclinicBox;
+
+/**
+ * @brief Fully flexible NPT move for triclinic boxes.
+ *
+ * Each move perturbs one of the six independent elements of the (upper-triangular) box matrix, i.e. one of the three
+ * sides or one of the three tilt factors, and deforms the particle positions affinely so that their fractional
+ * coordinates are preserved. Moves that would bring a tilt factor beyond half of the corresponding side or a
+ * perpendicular width of the box below twice the interaction cut-off are rejected. It requires box_type = triclinic.
+ *
+ * @verbatim
+type = triclinic (the move type)
+delta = <float> (maximum change of the box sides)
+[delta_tilt = <float> (maximum change of the tilt factors. Defaults to delta)]
+@endverbatim
+ */
+class TriclinicMove: public BaseMove {
+protected:
+	number _delta;
+	number _delta_tilt;
+	std::vector<LR_vector> _pos_old;
+
+	number _P;
+	TriclinicBox *_box;
+
+public:
+	TriclinicMove();
+	virtual ~TriclinicMove();
+
+	void apply(llint curr_step);
+	virtual void init();
+	virtual void get_settings(input_file &inp, input_file &sim_inp);
+	virtual void log_parameters();
+};
+#endif // TRICLINIC_MOVE_H_
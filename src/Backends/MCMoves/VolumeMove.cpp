@@ -104,7 +104,7 @@ void VolumeMove::apply(llint curr_step) {
 		if(curr_step < _equilibration_steps && _adjust_moves) {
 			_delta *= _acc_fact;
 		}
-		CONFIG_INFO->notify(CONFIG_INFO->box->UPDATE_EVENT);
+		CONFIG_INFO->notify_deferred(ConfigInfo::BOX_UPDATED);
 	}
 	else {
 		for(int k = 0; k < N; k++) {
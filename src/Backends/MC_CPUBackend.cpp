@@ -10,6 +10,7 @@
 #include "../Particles/BaseParticle.h"
 #include "../Observables/ObservableOutput.h"
 #include "../Managers/SimManager.h"
+#include "../Boxes/BoxDispatch.h"
 
 MC_CPUBackend::MC_CPUBackend() :
 				MCBackend() {
@@ -125,18 +126,48 @@ inline number MC_CPUBackend::_particle_energy(BaseParticle *p, bool reuse) {
 	}
 
 	std::vector<BaseParticle *> neighs = _lists->get_neigh_list(p);
-	for(unsigned int n = 0; n < neighs.size(); n++) {
-		BaseParticle *q = neighs[n];
-		res += _interaction->pair_interaction_nonbonded(p, q);
+	if(_interaction->has_energy_block_kernel()) {
+		res += _interaction->pair_interaction_nonbonded_energy_block(p, neighs);
 		if(_interaction->get_is_infinite() == true) {
 			_overlap = true;
 			return (number) 1.e12;
 		}
+		return res;
+	}
+
+	dispatch_box(_box.get(), [this, p, &neighs, &res](auto box) {
+		res += this->_nonbonded_energy(box, p, neighs);
+	});
+	if(_interaction->get_is_infinite() == true) {
+		_overlap = true;
+		return (number) 1.e12;
 	}
 
 	return res;
 }
 
+template<typename box_type>
+number MC_CPUBackend::_nonbonded_energy(const box_type *box, BaseParticle *p, const std::vector<BaseParticle *> &neighs) {
+	number res = (number) 0.f;
+	for(auto q : neighs) {
+		LR_vector r = box->min_image_direct(p->pos, q->pos);
+		_interaction->set_computed_r(r);
+		res += _interaction->pair_interaction_nonbonded(p, q, false, false);
+		if(_interaction->get_is_infinite() == true) {
+			break;
+		}
+	}
+
+	return res;
+}
+
+void MC_CPUBackend::recompute_cached_quantities() {
+	for(auto &stored : _stored_bonded_interactions) {
+		stored.second = _interaction->pair_interaction_bonded(stored.first.first, stored.first.second);
+	}
+	_compute_energy();
+}
+
 void MC_CPUBackend::_compute_energy() {
 	_interaction->begin_energy_computation();
 
@@ -266,7 +297,7 @@ void MC_CPUBackend::sim_step() {
 					}
 				}
 
-				CONFIG_INFO->notify(CONFIG_INFO->box->UPDATE_EVENT);
+				CONFIG_INFO->notify_deferred(ConfigInfo::BOX_UPDATED);
 			}
 			else {
 				// volume move rejected
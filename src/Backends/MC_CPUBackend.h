@@ -38,6 +38,12 @@ protected:
 	inline void _rotate_particle(BaseParticle *p);
 	inline number _particle_energy(BaseParticle *p, bool reuse=false);
 
+	/**
+	 * @brief Returns the non-bonded energy of p with the given neighbours, computing the distances with the box's concrete type. It stops as soon as an overlap is found.
+	 */
+	template<typename box_type>
+	number _nonbonded_energy(const box_type *box, BaseParticle *p, const std::vector<BaseParticle *> &neighs);
+
 	std::map<ParticlePair, number> _stored_bonded_interactions;
 	std::map<ParticlePair, number> _stored_bonded_tmp;
 
@@ -49,6 +55,7 @@ public:
 	void init();
 
 	void sim_step();
+	void recompute_cached_quantities();
 };
 
 #endif /* MC_CPUBACKEND_H_ */
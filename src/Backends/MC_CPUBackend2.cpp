@@ -101,16 +101,27 @@ void MC_CPUBackend2::sim_step() {
 }
 
 void MC_CPUBackend2::print_observables() {
-	std::string tmpstr("");
-	for(auto move : _moves) {
-		number ratio = move->get_acceptance();
-		tmpstr += Utils::sformat(" %5.3f", ratio);
+	if(_outputs_due()) {
+		std::string tmpstr("");
+		for(auto move : _moves) {
+			number ratio = move->get_acceptance();
+			tmpstr += Utils::sformat(" %5.3f", ratio);
+		}
+		_backend_info.insert(0, tmpstr + "  ");
 	}
-	_backend_info.insert(0, tmpstr + "  ");
 
 	SimBackend::print_observables();
 }
 
+void MC_CPUBackend2::get_metrics(std::vector<std::pair<std::string, number>> &metrics) {
+	// moves do not keep _U up to date, so we skip MCBackend's metrics
+	SimBackend::get_metrics(metrics);
+
+	for(uint i = 0; i < _moves.size(); i++) {
+		metrics.emplace_back(Utils::sformat("oxdna_acceptance_ratio{move=\"%u\"}", i), _moves[i]->get_acceptance());
+	}
+}
+
 void MC_CPUBackend2::print_equilibration_info() {
 	for(auto move : _moves) {
 		move->log_parameters();
@@ -37,6 +37,7 @@ public:
 	void add_move(std::string move_string, input_file &sim_inp);
 
 	void print_observables();
+	void get_metrics(std::vector<std::pair<std::string, number>> &metrics);
 
 	virtual void print_equilibration_info();
 };
@@ -169,8 +169,22 @@ void MDBackend::fix_diffusion() {
 	SimBackend::fix_diffusion();
 }
 
-void MDBackend::print_observables() {
+void MDBackend::get_metrics(std::vector<std::pair<std::string, number>> &metrics) {
+	SimBackend::get_metrics(metrics);
+
+	number K = 0.;
+	for(auto p : _particles) {
+		K += (p->vel.norm() + p->L.norm()) * 0.5;
+	}
+	metrics.emplace_back("oxdna_potential_energy", _U / N());
+	metrics.emplace_back("oxdna_kinetic_energy", K / N());
 	if(_use_barostat) {
+		metrics.emplace_back("oxdna_acceptance_ratio{move=\"barostat\"}", _barostat_acceptance);
+	}
+}
+
+void MDBackend::print_observables() {
+	if(_use_barostat && _outputs_due()) {
 		this->_backend_info.insert(0, Utils::sformat(" %5.3lf", _barostat_acceptance));
 	}
 
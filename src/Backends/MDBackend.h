@@ -71,6 +71,7 @@ public:
 	void fix_diffusion();
 
 	virtual void print_observables();
+	virtual void get_metrics(std::vector<std::pair<std::string, number>> &metrics);
 };
 
 #endif /* MDBACKEND_H_ */
@@ -11,6 +11,7 @@
 #include "Thermostats/ThermostatFactory.h"
 #include "Thermostats/NoThermostat.h"
 #include "MCMoves/MoveFactory.h"
+#include "../Boxes/BoxDispatch.h"
 
 MD_CPUBackend::MD_CPUBackend() :
 				MDBackend() {
@@ -142,10 +143,26 @@ void MD_CPUBackend::_first_step() {
 	}
 }
 
+void MD_CPUBackend::recompute_cached_quantities() {
+	// these are the forces that will be used in the first half of the next step
+	for(auto p : _particles) {
+		p->set_initial_forces(current_step(), _box.get());
+	}
+	_compute_forces();
+}
+
 void MD_CPUBackend::_compute_forces() {
 	_interaction->begin_energy_and_force_computation();
 
 	_U = (number) 0;
+	dispatch_box(_box.get(), [this](auto box) {
+		this->_compute_forces(box);
+	});
+}
+
+template<typename box_type>
+void MD_CPUBackend::_compute_forces(const box_type *box) {
+	bool use_block_kernel = _interaction->has_neighbour_block_kernel();
 	for(auto p : _particles) {
 		for(auto &pair : p->affected) {
 			if(pair.first == p) {
@@ -153,8 +170,16 @@ void MD_CPUBackend::_compute_forces() {
 			}
 		}
 
-		for(auto q : _lists->get_neigh_list(p)) {
-			_U += _interaction->pair_interaction_nonbonded(p, q, true, true);
+		if(use_block_kernel) {
+			_U += _interaction->pair_interaction_nonbonded_block(p, _lists->get_neigh_list(p), true);
+		}
+		else {
+			for(auto q : _lists->get_neigh_list(p)) {
+				// the distance is computed here so that the minimum image convention can be inlined
+				LR_vector r = box->min_image_direct(p->pos, q->pos);
+				_interaction->set_computed_r(r);
+				_U += _interaction->pair_interaction_nonbonded(p, q, false, true);
+			}
 		}
 	}
 }
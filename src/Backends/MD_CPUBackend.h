@@ -32,6 +32,12 @@ protected:
 
 	void _first_step();
 	void _compute_forces();
+
+	/**
+	 * @brief Computes the forces, computing the distances with the box's concrete type. Called by _compute_forces().
+	 */
+	template<typename box_type>
+	void _compute_forces(const box_type *box);
 	void _second_step();
 
 	void _update_backend_info();
@@ -43,6 +49,7 @@ public:
 	void init();
 	void get_settings(input_file &inp);
 	void sim_step();
+	void recompute_cached_quantities();
 	void activate_thermostat();
 };
 
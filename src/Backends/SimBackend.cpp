@@ -7,6 +7,7 @@
 
 #include <sstream>
 #include <fstream>
+#include <algorithm>
 
 #include "SimBackend.h"
 #include "../Utilities/Utils.h"
@@ -16,8 +17,10 @@
 #include "../Forces/ForceFactory.h"
 #include "../Lists/ListFactory.h"
 #include "../Boxes/BoxFactory.h"
+#include "../Boxes/TriclinicBox.h"
 #include "../PluginManagement/PluginManager.h"
 #include "../Particles/BaseParticle.h"
+#include "../Particles/ParticleArena.h"
 #include "../Utilities/Timings.h"
 
 SimBackend::SimBackend() {
@@ -48,13 +51,14 @@ SimBackend::SimBackend() {
 	_obs_output_trajectory = _obs_output_stdout = _obs_output_file = _obs_output_reduced_conf = _obs_output_last_conf = _obs_output_checkpoints = _obs_output_last_checkpoint = nullptr;
 	_mytimer = nullptr;
 	_restart_step_counter = false;
+	_compact_particles = false;
 	_rcut = -1.;
 	_sqr_rcut = -1.;
 	_T = -1.;
 
 	ConfigInfo::init(&_particles, &_molecules);
 	_config_info = ConfigInfo::instance().get();
-	_config_info->subscribe("T_updated", [this]() {
+	_config_info->subscribe(ConfigInfo::T_UPDATED, [this]() {
 		this->_on_T_update();
 	});
 }
@@ -149,6 +153,7 @@ void SimBackend::get_settings(input_file &inp) {
 	}
 
 	getInputBool(&inp, "fix_diffusion", &_enable_fix_diffusion, 0);
+	getInputNumber(&inp, "orthonormalisation_threshold", &_orthonormalisation_threshold, 0);
 
 	// we only reseed the RNG if:
 	// a) we have a binary conf
@@ -264,6 +269,11 @@ void SimBackend::get_settings(input_file &inp) {
 
 	getInputBool(&inp, "external_forces", &_external_forces, 0);
 
+	getInputBool(&inp, "compact_particles", &_compact_particles, 0);
+
+	bool particle_arena = true;
+	getInputBool(&inp, "particle_arena", &particle_arena, 0);
+	ParticleArena::instance().set_enabled(particle_arena);
 }
 
 void SimBackend::init() {
@@ -277,6 +287,7 @@ void SimBackend::init() {
 	// check number of particles
 	int N = _interaction->get_N_from_topology();
 	_particles.resize(N);
+	ParticleArena::instance().reserve(N);
 	_interaction->read_topology(&_N_strands, _particles);
 
 	_rcut = _interaction->get_rcut();
@@ -348,10 +359,22 @@ void SimBackend::init() {
 		}
 	}
 
+	if(_compact_particles) {
+		for(auto p : _particles) {
+			p->shrink_to_fit();
+		}
+		for(auto mol : _molecules) {
+			mol->particles.shrink_to_fit();
+		}
+	}
+
 	_interaction->set_box(_box.get());
 
 	_lists->init(_rcut);
-	CONFIG_INFO->subscribe(_box->INIT_EVENT, [this]() { this->_lists->change_box(); });
+	CONFIG_INFO->subscribe(ConfigInfo::BOX_INITIALISED, [this]() { this->_lists->change_box(); });
+	// the interaction has subscribed to T_UPDATED in its constructor, so by the time this callback is invoked its
+	// temperature-dependent parameters (and possibly its cutoff) have already been updated
+	CONFIG_INFO->subscribe(ConfigInfo::T_UPDATED, [this]() { this->_on_interaction_T_update(); });
 
 	_config_info->set(_interaction.get(), &_backend_info, _lists.get(), _box.get());
 
@@ -379,6 +402,9 @@ LR_vector SimBackend::_read_next_binary_vector() {
 // here we cannot use _molecules because it has not been initialised yet
 bool SimBackend::read_next_configuration(bool binary) {
 	double Lx, Ly, Lz;
+	// tilt factors, which can be specified in the headers of configurations of triclinic boxes
+	double xy = 0., xz = 0., yz = 0.;
+	int N_box_values = 3;
 	// parse headers. Binary and ascii configurations have different headers, and hence
 	// we have to separate the two procedures
 	if(binary) {
@@ -430,9 +456,9 @@ bool SimBackend::read_next_configuration(bool binary) {
 		if(!malformed_headers) {
 			std::getline(_conf_input, line);
 			// handle the case when the box_size can't be read
-			res += sscanf(line.c_str(), "b = %lf %lf %lf", &Lx, &Ly, &Lz);
-			if(res != 4) {
-				error_message << "Malformed headers found in an input configuration.\"b = <float> <float> <float>\" was expected, but \"" << line << "\" was found instead.";
+			N_box_values = sscanf(line.c_str(), "b = %lf %lf %lf %lf %lf %lf", &Lx, &Ly, &Lz, &xy, &xz, &yz);
+			if(N_box_values != 3 && N_box_values != 6) {
+				error_message << "Malformed headers found in an input configuration.\"b = <float> <float> <float>\" (or \"b = <float> <float> <float> <float> <float> <float>\" for triclinic boxes) was expected, but \"" << line << "\" was found instead.";
 				malformed_headers = true;
 			}
 		}
@@ -448,7 +474,21 @@ bool SimBackend::read_next_configuration(bool binary) {
 		std::getline(_conf_input, line);
 	}
 
-	_box->init(Lx, Ly, Lz);
+	if(N_box_values == 6) {
+		auto triclinic_box = dynamic_cast<TriclinicBox *>(_box.get());
+		if(triclinic_box != nullptr) {
+			triclinic_box->init(Lx, Ly, Lz, xy, xz, yz);
+		}
+		else if(xy != 0. || xz != 0. || yz != 0.) {
+			throw oxDNAException("The configuration file contains a non-orthogonal box (tilts: %lf %lf %lf), which requires 'box_type = triclinic'", xy, xz, yz);
+		}
+		else {
+			_box->init(Lx, Ly, Lz);
+		}
+	}
+	else {
+		_box->init(Lx, Ly, Lz);
+	}
 
 	// the following part is always carried out in double precision since we want to be able to restart from confs that have
 	// large numbers in the conf file and use float precision later
@@ -544,6 +584,9 @@ bool SimBackend::read_next_configuration(bool binary) {
 		}
 	}
 
+	// the cached properties of the molecules refer to the previous configuration
+	invalidate_molecules();
+
 	_interaction->check_input_sanity(_particles);
 
 	return true;
@@ -553,6 +596,23 @@ void SimBackend::_on_T_update() {
 	_T = _config_info->temperature();
 }
 
+void SimBackend::_on_interaction_T_update() {
+	number new_rcut = _interaction->get_rcut();
+	// a larger cutoff does not make the lists wrong, so we do not shrink them
+	if(new_rcut > _rcut) {
+		OX_LOG(Logger::LOG_INFO, "The cutoff of the interaction has grown from %lf to %lf, re-initialising the lists", _rcut, new_rcut);
+		_rcut = new_rcut;
+		_sqr_rcut = SQR(_rcut);
+		_on_rcut_update();
+	}
+
+	recompute_cached_quantities();
+}
+
+void SimBackend::_on_rcut_update() {
+	_lists->init(_rcut);
+}
+
 void SimBackend::apply_simulation_data_changes() {
 
 }
@@ -561,8 +621,13 @@ void SimBackend::apply_changes_to_simulation_data() {
 
 }
 
+void SimBackend::recompute_cached_quantities() {
+
+}
+
 void SimBackend::add_output(ObservableOutputPtr new_output) {
 	_obs_outputs.push_back(new_output);
+	_obs_schedule_dirty = true;
 }
 
 void SimBackend::remove_output(std::string output_file) {
@@ -572,26 +637,85 @@ void SimBackend::remove_output(std::string output_file) {
 	}
 
 	_obs_outputs.erase(search);
+	_obs_schedule_dirty = true;
+}
+
+void SimBackend::_build_obs_schedule(llint step) {
+	_obs_schedule = decltype(_obs_schedule)();
+	for(int i = 0; i < (int) _obs_outputs.size(); i++) {
+		llint next = _obs_outputs[i]->next_ready_step(step);
+		if(next > -1) {
+			_obs_schedule.emplace(next, i);
+		}
+	}
+	_obs_schedule_dirty = false;
+}
+
+bool SimBackend::_outputs_due() {
+	llint step = current_step();
+	// the schedule is rebuilt if outputs have been added or removed, or if we are asked about a step that has been
+	// already processed (which may happen, for instance, when analysing trajectories)
+	if(_obs_schedule_dirty || step <= _obs_schedule_last_step) {
+		_build_obs_schedule(step);
+	}
+
+	return !_obs_schedule.empty() && _obs_schedule.top().first <= step;
 }
 
 void SimBackend::print_observables() {
 	_mytimer->resume();
 	_obs_timer->resume();
 
-	bool someone_ready = false;
-	for(auto const &element : _obs_outputs) {
-		if(element->is_ready(current_step()))
-			someone_ready = true;
+	// we first find out which outputs should be printed on this step, so that all the observables that they contain
+	// can be computed in a single batch that shares the expensive (e.g. energy) sweeps
+	llint step = current_step();
+	std::vector<int> ready_outputs;
+	if(_outputs_due()) {
+		while(!_obs_schedule.empty() && _obs_schedule.top().first <= step) {
+			int idx = _obs_schedule.top().second;
+			llint next = _obs_schedule.top().first;
+			_obs_schedule.pop();
+			// the output was due on a step that has been skipped
+			if(next < step) {
+				next = _obs_outputs[idx]->next_ready_step(step);
+			}
+
+			if(next == step) {
+				ready_outputs.push_back(idx);
+			}
+			else if(next > -1) {
+				_obs_schedule.emplace(next, idx);
+			}
+		}
 	}
+	_obs_schedule_last_step = step;
+	// outputs are printed in the order with which they have been added
+	std::sort(ready_outputs.begin(), ready_outputs.end());
 
-	if(someone_ready) {
+	if(ready_outputs.size() > 0) {
 		apply_simulation_data_changes();
 
+		_config_info->begin_observable_batch();
+		try {
+			for(auto idx : ready_outputs) {
+				_obs_outputs[idx]->print_output(step);
+			}
+		}
+		catch(...) {
+			_config_info->end_observable_batch();
+			throw;
+		}
+		_config_info->end_observable_batch();
+
+		for(auto idx : ready_outputs) {
+			llint next = _obs_outputs[idx]->next_ready_step(step + 1);
+			if(next > -1) {
+				_obs_schedule.emplace(next, idx);
+			}
+		}
+
 		llint total_bytes = 0;
 		for(auto const &element : _obs_outputs) {
-			if(element->is_ready(current_step())) {
-				element->print_output(current_step());
-			}
 			total_bytes += element->get_bytes_written();
 		}
 
@@ -634,102 +758,123 @@ void SimBackend::update_observables_data() {
 	_obs_timer->pause();
 }
 
-void SimBackend::fix_diffusion() {
-	if(!_enable_fix_diffusion) {
-		return;
+void SimBackend::get_metrics(std::vector<std::pair<std::string, number>> &metrics) {
+	metrics.emplace_back("oxdna_step", (number) current_step());
+	metrics.emplace_back("oxdna_particles", (number) N());
+	metrics.emplace_back("oxdna_list_updates_total", (number) _N_updates);
+	metrics.emplace_back("oxdna_resident_memory_bytes", (number) Utils::get_resident_memory());
+	for(auto &usage : get_memory_usage()) {
+		metrics.emplace_back(Utils::sformat("oxdna_memory_bytes{subsystem=\"%s\"}", usage.first.c_str()), (number) usage.second);
 	}
+}
 
-	apply_simulation_data_changes();
+std::vector<std::pair<std::string, llint>> SimBackend::get_memory_usage() {
+	llint particles = (llint) _particles.capacity() * sizeof(BaseParticle *);
+	if(ParticleArena::instance().enabled()) {
+		particles += ParticleArena::instance().used_bytes();
+	}
+	else {
+		// the particle objects are accounted for with the size of the base class, so this is a lower bound
+		particles += (llint) _particles.size() * sizeof(BaseParticle);
+	}
+	llint particle_arrays = 0;
+	for(auto p : _particles) {
+		particle_arrays += p->heap_footprint();
+	}
 
+	llint molecules = 0;
 	for(auto mol : _molecules) {
-		mol->update_com();
+		molecules += sizeof(Molecule) + (llint) mol->particles.capacity() * sizeof(BaseParticle *);
 	}
 
-	static std::vector<LR_vector> stored_pos(N());
-	static std::vector<LR_matrix> stored_or(N());
-	static std::vector<LR_matrix> stored_orT(N());
-
-	// we can't exclude the possibility that N() might change during the course of the simulation
-	stored_pos.resize(N());
-	stored_or.resize(N());
-	stored_orT.resize(N());
+	std::vector<std::pair<std::string, llint>> usage;
+	usage.emplace_back("particles", particles);
+	usage.emplace_back("particle_arrays", particle_arrays);
+	usage.emplace_back("molecules", molecules);
+	usage.emplace_back("lists", (_lists != nullptr) ? _lists->memory_footprint() : 0);
+	usage.emplace_back("interaction", (_interaction != nullptr) ? _interaction->memory_footprint() : 0);
 
-	number E_before = _interaction->get_system_energy(_particles, _lists.get());
-	for(int i = 0; i < N(); i++) {
-		BaseParticle *p = _particles[i];
-		stored_pos[i] = p->pos;
-		stored_or[i] = p->orientation;
-		stored_orT[i] = p->orientationT;
+	llint observables = 0;
+	for(auto &output : _obs_outputs) {
+		observables += output->memory_footprint();
 	}
+	usage.emplace_back("observables", observables);
 
-	// change particle position and fix orientation matrix;
-	for(int i = 0; i < N(); i++) {
-		BaseParticle *p = _particles[i];
-		if(_molecules[p->strand_id]->shiftable()) {
-			_box->shift_particle(p, _molecules[p->strand_id]->com);
-			p->orientation.orthonormalize();
-			p->orientationT = p->orientation.get_transpose();
-			p->set_positions();
+	llint resident = Utils::get_resident_memory();
+	if(resident > 0) {
+		llint accounted = 0;
+		for(auto &entry : usage) {
+			accounted += entry.second;
 		}
+		usage.emplace_back("other", std::max(resident - accounted, (llint) 0));
 	}
 
-	number E_after = _interaction->get_system_energy(_particles, _lists.get());
-	if(_interaction->get_is_infinite() == true || fabs(E_before - E_after) > 1.e-6 * fabs(E_before)) {
-		OX_LOG(Logger::LOG_INFO, "Fix diffusion went too far... %g, %g, %d, (%g>%g)", E_before, E_after, _interaction->get_is_infinite(), fabs(E_before - E_after), 1.e-6 * fabs(E_before));
-		_interaction->set_is_infinite(false);
-		for(int i = 0; i < N(); i++) {
-			BaseParticle *p = _particles[i];
-			LR_vector dscdm = -_molecules[p->strand_id]->com;
-			_box->shift_particle(p, dscdm);
-			p->orientation = stored_or[i];
-			p->orientationT = stored_orT[i];
-			p->set_positions();
-		}
+	return usage;
+}
 
-		// we try to normalize a few of them...
-		std::vector<int> apply;
-		for(auto molecule : _molecules) {
-			if(drand48() < 0.005) {
-				apply.push_back(1);
-			}
-			else
-				apply.push_back(0);
-		}
+void SimBackend::print_memory_usage() {
+	OX_LOG(Logger::LOG_INFO, "Estimated memory usage (resident: %s):", Utils::bytes_to_human(Utils::get_resident_memory()).c_str());
+	for(auto &entry : get_memory_usage()) {
+		OX_LOG(Logger::LOG_NOTHING, "\t%s: %s", entry.first.c_str(), Utils::bytes_to_human(entry.second).c_str());
+	}
+}
 
-		for(int i = 0; i < N(); i++) {
-			BaseParticle *p = _particles[i];
-			if(apply[p->strand_id]) {
-				p->orientation.orthonormalize();
-				p->orientationT = p->orientation.get_transpose();
-				p->set_positions();
-			}
-		}
+void SimBackend::fix_diffusion() {
+	if(!_enable_fix_diffusion) {
+		return;
+	}
 
-		number E_after2 = _interaction->get_system_energy(_particles, _lists.get());
-		if(_interaction->get_is_infinite() == true || fabs(E_before - E_after2) > 1.e-6 * fabs(E_before)) {
-			OX_LOG(Logger::LOG_INFO, " *** Fix diffusion hopeless... %g, %g, %d, (%g>%g)", E_before, E_after2, _interaction->get_is_infinite(), fabs(E_before - E_after2), 1.e-6 * fabs(E_before));
-			_interaction->set_is_infinite(false);
-			for(int i = 0; i < N(); i++) {
-				BaseParticle *p = _particles[i];
-				if(apply[p->strand_id]) {
-					p->pos = stored_pos[i];
-					p->orientation = stored_or[i];
-					p->orientationT = stored_orT[i];
-					p->set_positions();
-				}
-			}
+	apply_simulation_data_changes();
+
+	// molecules are shifted as a whole by a lattice vector, which leaves all the distances (computed with the minimum
+	// image convention or not) and hence the energy unchanged. There is no need to check the energy before and after
+	int N_shifted = 0;
+	for(auto mol : _molecules) {
+		if(!mol->shiftable()) {
+			continue;
 		}
-		else {
-			OX_LOG(Logger::LOG_INFO, "diffusion PARTIALLY fixed");
+
+		mol->update_properties();
+		LR_vector com = mol->com;
+		for(auto p : mol->particles) {
+			_box->shift_particle(p, com);
+			_lists->single_update(p);
 		}
-	}
-	else {
-		OX_LOG(Logger::LOG_INFO, "diffusion fixed.. %g %g", E_before, E_after);
+		mol->invalidate();
+		N_shifted++;
 	}
 
+	int N_orthonormalised = _orthonormalise_orientations();
+
+	OX_DEBUG("Diffusion fixed: %d molecules shifted, %d orientations re-orthonormalised", N_shifted, N_orthonormalised);
+
 	apply_changes_to_simulation_data();
 }
 
+int SimBackend::_orthonormalise_orientations() {
+	int N_orthonormalised = 0;
+	for(auto p : _particles) {
+		const LR_matrix &o = p->orientation;
+		number drift = std::max({
+			fabs(o.v1.module() - (number) 1.),
+			fabs(o.v2.module() - (number) 1.),
+			fabs(o.v3.module() - (number) 1.),
+			fabs(o.v1 * o.v2),
+			fabs(o.v1 * o.v3),
+			fabs(o.v2 * o.v3)
+		});
+
+		if(drift > _orthonormalisation_threshold) {
+			p->orientation.orthonormalize();
+			p->orientationT = p->orientation.get_transpose();
+			p->set_positions();
+			N_orthonormalised++;
+		}
+	}
+
+	return N_orthonormalised;
+}
+
 void SimBackend::print_conf(bool reduced, bool only_last) {
 	apply_simulation_data_changes();
 
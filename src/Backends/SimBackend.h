@@ -21,6 +21,7 @@
 #include <cfloat>
 #include <vector>
 #include <map>
+#include <queue>
 
 class IBaseInteraction;
 class BaseBox;
@@ -37,6 +38,7 @@ class Timer;
  T = <float> (temperature of the simulation. It can be expressed in simulation units or kelvin (append a k or K after the value) or celsius (append a c or C after the value).)
 
  [fix_diffusion = <bool> (if true, particles that leave the simulation box are brought back in via periodic boundary conditions. Defaults to true.)]
+ [orthonormalisation_threshold = <float> (when diffusion is fixed, the orientation matrices that deviate from orthonormality by more than this amount are re-orthonormalised. Defaults to 1e-6)]
  [seed = <int> (seed for the random number generator. On Unix systems, defaults to either a number from /dev/urandom or to time(NULL))]
 
  [confs_to_skip = <int> (how many configurations should be skipped before using the next one as the initial configuration, defaults to 0)]
@@ -65,6 +67,9 @@ class Timer;
  [checkpoint_trajectory = <string> (File name for the checkpoint trajectory. If not specified, only the last checkpoint will be printed)]
  [reload_from = <string> (checkpoint to reload from. This option is incompatible with the keys conf_file and seed, and requires restart_step_counter=0 as well as binary_initial_conf!=1)]
 
+ [particle_arena = <bool> (if true, particles are allocated contiguously in large chunks of memory rather than one by one. Defaults to true)]
+ [compact_particles = <bool> (if true, the spare capacity of the per-particle arrays is released once the particles have been initialised. Useful to reduce the memory footprint of very large systems. Defaults to false)]
+
  @endverbatim
  */
 class SimBackend {
@@ -76,6 +81,15 @@ protected:
 	number _max_io;
 
 	bool _enable_fix_diffusion;
+	/// orientation matrices that deviate from orthonormality by more than this amount get re-orthonormalised by fix_diffusion()
+	number _orthonormalisation_threshold = 1e-6;
+
+	/**
+	 * @brief Re-orthonormalises the orientation matrices whose rows have drifted away from an orthonormal set by more than _orthonormalisation_threshold.
+	 *
+	 * @return the number of particles whose orientation has been re-orthonormalised
+	 */
+	int _orthonormalise_orientations();
 
 	bool _external_forces;
 	std::string _external_filename;
@@ -100,6 +114,7 @@ protected:
 	std::string _checkpoint_file;
 	std::string _checkpoint_traj;
 	bool _restart_step_counter;
+	bool _compact_particles;
 
 	/// Vector of ObservableOutput used to manage the simulation output
 	std::vector<ObservableOutputPtr> _obs_outputs;
@@ -112,6 +127,11 @@ protected:
 	ObservableOutputPtr _obs_output_checkpoints;
 	ObservableOutputPtr _obs_output_last_checkpoint;
 
+	/// min-heap of (next step at which the output is ready, index of the output in _obs_outputs) pairs
+	std::priority_queue<std::pair<llint, int>, std::vector<std::pair<llint, int>>, std::greater<std::pair<llint, int>>> _obs_schedule;
+	bool _obs_schedule_dirty = true;
+	llint _obs_schedule_last_step = -1;
+
 	/// Shared pointer to the interaction manager
 	InteractionPtr _interaction;
 
@@ -146,6 +166,29 @@ protected:
 
 	virtual void _on_T_update();
 
+	/**
+	 * @brief Called after the interaction has updated its temperature-dependent parameters. It updates the cutoff if
+	 * the one of the interaction has grown and then calls recompute_cached_quantities().
+	 */
+	virtual void _on_interaction_T_update();
+
+	/**
+	 * @brief Called after the cutoff has grown, it re-initialises the lists so that they take into account the new cutoff.
+	 */
+	virtual void _on_rcut_update();
+
+	/**
+	 * @brief Rebuilds the schedule that stores the next step at which each output should be printed.
+	 *
+	 * @param step the current step
+	 */
+	void _build_obs_schedule(llint step);
+
+	/**
+	 * @brief Returns true if at least one output should be printed at the current step. It does O(1) work when no output is due.
+	 */
+	bool _outputs_due();
+
 public:
 	SimBackend();
 	virtual ~SimBackend();
@@ -199,6 +242,25 @@ public:
 
 	virtual void update_observables_data();
 
+	/**
+	 * @brief Appends to the given vector the (name, value) pairs that describe the current state of the simulation. Used to export live metrics.
+	 *
+	 * @param metrics
+	 */
+	virtual void get_metrics(std::vector<std::pair<std::string, number>> &metrics);
+
+	/**
+	 * @brief Returns an estimate of the memory used by each subsystem (particles, lists, interaction, molecules, etc.), in bytes.
+	 *
+	 * The "other" entry contains the difference between the resident memory of the process and the sum of all the other entries.
+	 */
+	virtual std::vector<std::pair<std::string, llint>> get_memory_usage();
+
+	/**
+	 * @brief Prints the output of get_memory_usage() to the log.
+	 */
+	void print_memory_usage();
+
 	virtual void print_conf(bool reduced=false, bool only_last=false);
 
 	/**
@@ -216,12 +278,31 @@ public:
 	 */
 	virtual void apply_changes_to_simulation_data();
 
+	/**
+	 * @brief Recompute the quantities that the backend keeps from one step to the next (e.g. energies or forces).
+	 *
+	 * Should be called when the configuration or the interaction parameters have been changed from outside the
+	 * backend. The default implementation does nothing.
+	 */
+	virtual void recompute_cached_quantities();
+
 	long long int current_step() {
 		return _config_info->curr_step;
 	}
 
 	void increment_current_step() {
 		_config_info->curr_step++;
+		// the particles have been moved by the step that has just been completed
+		invalidate_molecules();
+	}
+
+	/**
+	 * @brief Discard the properties cached by the molecules. Should be called whenever the particles are moved outside of a simulation step
+	 */
+	void invalidate_molecules() {
+		for(auto &mol : _molecules) {
+			mol->invalidate();
+		}
 	}
 
 	llint start_step_from_file;
@@ -11,7 +11,7 @@ BaseThermostat::BaseThermostat() :
 				_T((number) 0.f),
 				_supports_shear(false),
 				_lees_edwards(false) {
-	CONFIG_INFO->subscribe("T_updated", [this]() { this->_on_T_update(); });
+	CONFIG_INFO->subscribe(ConfigInfo::T_UPDATED, [this]() { this->_on_T_update(); });
 }
 
 void BaseThermostat::get_settings(input_file &inp) {
@@ -15,6 +15,7 @@ BrownianThermostat::BrownianThermostat () : BaseThermostat(){
 	_pr = (number) 0.f;
 	_dt = (number) 0.f;
 	_diff_coeff = (number) 0.f;
+	_input_pt = _input_diff_coeff = (number) 0.f;
 	_rescale_factor = (number) 0.f;
 }
 
@@ -32,9 +33,9 @@ void BrownianThermostat::get_settings (input_file &inp) {
 	if(getInputFloat(&inp, "pt", &tmp_pt, 0) == KEY_NOT_FOUND) {
 		if(getInputFloat(&inp, "diff_coeff", &tmp_diff_coeff, 0) == KEY_NOT_FOUND)
 			throw oxDNAException ("pt or diff_coeff must be specified for the John thermostat");
-		else _diff_coeff = (number) tmp_diff_coeff;
+		else _input_diff_coeff = (number) tmp_diff_coeff;
 	}
-	else _pt = (number) tmp_pt;
+	else _input_pt = (number) tmp_pt;
 	getInputFloat(&inp, "dt", &tmp_dt, 1);
 	_dt = (number) tmp_dt;
 }
@@ -42,7 +43,9 @@ void BrownianThermostat::get_settings (input_file &inp) {
 
 void BrownianThermostat::init() {
     BaseThermostat::init();
-	if(_pt == (number) 0.) _pt = (2 * this->_T *  _newtonian_steps * _dt)/(this->_T * _newtonian_steps * _dt + 2 * _diff_coeff);
+	// init() is called again whenever the temperature changes, hence we start from the input values
+	_pt = _input_pt;
+	if(_pt == (number) 0.) _pt = (2 * this->_T *  _newtonian_steps * _dt)/(this->_T * _newtonian_steps * _dt + 2 * _input_diff_coeff);
 	if(_pt > (number) 1.) throw oxDNAException ("pt (%f) must be smaller than 1", _pt);
 
 	// initialize pr (considering Dr = 3Dt)
@@ -23,6 +23,8 @@ protected:
 	int _newtonian_steps;
 	number _pt, _pr, _dt;
 	number _diff_coeff;
+	/// the values of pt and diff_coeff given in the input (0 if not given), which are used to compute _pt and _diff_coeff every time init() is called
+	number _input_pt, _input_diff_coeff;
 	number _rescale_factor;
 public:
 	BrownianThermostat();
@@ -17,6 +17,7 @@ LangevinThermostat::LangevinThermostat() :
 	_diff_coeff_rot = (number) 0.f;
 	_rescale_factor_trans = (number) 0.f;
 	_rescale_factor_rot = (number) 0.f;
+	_fixed_gamma = false;
 
 	this->_supports_shear = true;
 }
@@ -44,6 +45,7 @@ void LangevinThermostat::get_settings(input_file &inp) {
 	else {
 		if(getInputFloat(&inp, "gamma_trans", &tmp_gamma, 0) == KEY_FOUND) {
 			_gamma_trans = (number) tmp_gamma;
+			_fixed_gamma = true;
 			if(_gamma_trans <= 0.) throw oxDNAException("Unreasonable value %g for gamma_trans. Allowed values are > 0.", _gamma_trans);
 		}
 		else {
@@ -57,7 +59,8 @@ void LangevinThermostat::get_settings(input_file &inp) {
 void LangevinThermostat::init() {
 	BaseThermostat::init();
 
-	if(_diff_coeff_trans == 0.) {
+	// init() is called again whenever the temperature changes, and the coefficient given in the input should not change
+	if(_fixed_gamma) {
 		_diff_coeff_trans = this->_T / _gamma_trans;
 	}
 	else {
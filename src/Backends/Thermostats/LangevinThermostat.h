@@ -38,6 +38,9 @@ protected:
 	/// Angular velocity damping coefficient = diff_coeff_rot / T
 	number _gamma_rot;
 
+	/// true if the user set gamma_trans rather than diff_coeff, which is then kept fixed when the temperature changes
+	bool _fixed_gamma;
+
 public:
 	LangevinThermostat();
 	virtual ~LangevinThermostat();
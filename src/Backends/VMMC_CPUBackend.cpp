@@ -36,10 +36,14 @@ VMMC_CPUBackend::VMMC_CPUBackend() :
 	_skip_hist_zeros = false;
 	_vmmc_N_cells = 0;
 	_vmmc_box_side = -1.;
+	_cubic_box = NULL;
 	_equilibration_steps = 0;
 	_vmmc_N_cells_side = -1;
 	_reload_hist = false;
 	_just_updated_lists = false;
+	_strand_pruning = false;
+	_strand_pruning_margin = 1.;
+	_sparse_cells = false;
 
 	_dU = 0.;
 	_U_stack = 0.;
@@ -111,6 +115,8 @@ void VMMC_CPUBackend::init() {
 	}
 
 	_vmmc_box_side = _box->box_sides()[0];
+	// pair energies are evaluated many times per move, so we avoid the virtual min_image() whenever we can
+	_cubic_box = (_box->geometry() == BaseBox::CUBIC) ? static_cast<const CubicBox *>(_box.get()) : NULL;
 
 	// setting the maximum displacement
 	if(_preserve_topology) {
@@ -128,19 +134,6 @@ void VMMC_CPUBackend::init() {
 	new_en5s.resize(N(), 0.);
 	new_stn3s.resize(N(), 0.);
 	new_stn5s.resize(N(), 0.);
-	number tmpf, epq;
-	BaseParticle * p, *q;
-	for(int k = 0; k < N(); k++) {
-		p = _particles[k];
-		if(p->n3 != P_VIRTUAL) {
-			q = p->n3;
-			epq = _particle_particle_bonded_interaction_n3_VMMC(p, q, &tmpf);
-			p->en3 = epq;
-			q->en5 = epq;
-			p->esn3 = tmpf;
-			q->esn5 = tmpf;
-		}
-	}
 
 	if(_small_system) {
 		eijm = new number*[N()];
@@ -153,21 +146,16 @@ void VMMC_CPUBackend::init() {
 			hbijm[k] = new bool[N()];
 			hbijm_old[k] = new bool[N()];
 		}
-
-		for(int k = 0; k < N(); k++) {
-			for(int l = 0; l < k; l++) {
-				p = _particles[k];
-				q = _particles[l];
-				if(p->n3 != q && p->n5 != q) {
-					eijm[k][l] = eijm[l][k] = eijm_old[k][l] = eijm_old[l][k] = _particle_particle_nonbonded_interaction_VMMC(p, q, &tmpf);
-					hbijm[k][l] = hbijm[l][k] = hbijm_old[k][l] = hbijm_old[l][k] = (tmpf < HB_CUTOFF);
-				}
-			}
-		}
 	}
 
+	_compute_stored_energies();
+
 	_init_cells();
 
+	if(_strand_pruning) {
+		_strand_spheres.init(_molecules, _rcut, _strand_pruning_margin);
+	}
+
 	_compute_energy();
 
 	check_overlaps();
@@ -220,6 +208,9 @@ void VMMC_CPUBackend::get_settings(input_file & inp) {
 	}
 
 	getInputBool(&inp, "preserve_topology", &_preserve_topology, 0);
+	getInputBool(&inp, "strand_pruning", &_strand_pruning, 0);
+	getInputNumber(&inp, "strand_pruning_margin", &_strand_pruning_margin, 0);
+	getInputBool(&inp, "cells_sparse", &_sparse_cells, 0);
 
 	if(getInputBoolAsInt(&inp, "umbrella_sampling", &is_us, 0) != KEY_NOT_FOUND) {
 		if(is_us > 0) {
@@ -403,7 +394,7 @@ inline number VMMC_CPUBackend::_particle_particle_nonbonded_interaction_VMMC(Bas
 	if(H_energy != 0)
 	*H_energy = (number) 0;
 
-	LR_vector r = _box->min_image(p->pos, q->pos);
+	LR_vector r = (_cubic_box != NULL) ? _cubic_box->min_image_direct(p->pos, q->pos) : _box->min_image(p->pos, q->pos);
 
 	// early ejection
 	if(r.norm() > _sqr_rcut) {
@@ -832,6 +823,10 @@ inline number VMMC_CPUBackend::build_cluster_cells(movestr *moveptr, int maxsize
 
 	_reject_prelinks = false;
 
+	// pairs of nucleotides that belong to strands whose bounding spheres are far apart can be skipped, provided that
+	// the spheres are up to date and contain both the old and the new positions of the moving nucleotide
+	bool prune_strands = _strand_pruning && _strand_spheres.is_updated();
+
 	set<int> prelinked_particles; //number of prelinked particles
 	//set<base_pair, classcomp> poss_anomalies; //number of prelinked particles
 	//set<base_pair, classcomp> poss_breaks; //number of prelinked particles
@@ -990,11 +985,13 @@ inline number VMMC_CPUBackend::build_cluster_cells(movestr *moveptr, int maxsize
 		}
 
 		// a celle:
+		bool prune = prune_strands && _strand_spheres.contains(pp);
+		const int *neighcells = _cell_neighbours(_cells[pp->index]);
 		for(int c = 0; c < 27; c++) {
-			icell = _neighcells[_cells[pp->index]][c];
+			icell = neighcells[c];
 			//icell = cell_neighbours (_cells[pp->index], c);
 			//assert (icell == _neighcells[_cells[pp->index]][c]);
-			neigh = _vmmc_heads[icell];
+			neigh = _cell_head(icell);
 			while(neigh != P_INVALID) {
 				qq = _particles[neigh]; //qq is my neighbor
 
@@ -1003,6 +1000,11 @@ inline number VMMC_CPUBackend::build_cluster_cells(movestr *moveptr, int maxsize
 					continue;
 				}
 
+				if(prune && !_strand_spheres.close(pp->strand_id, qq->strand_id)) {
+					neigh = qq->next_particle;
+					continue;
+				}
+
 				if(qq->inclust == false) {
 					E_old = _particle_particle_nonbonded_interaction_VMMC(_particles_old[pp->index], qq, &H_temp);
 
@@ -1128,11 +1130,13 @@ inline number VMMC_CPUBackend::build_cluster_cells(movestr *moveptr, int maxsize
 			}
 		}
 
+		bool prune = prune_strands && _strand_spheres.contains(pp);
+		const int *neighcells = _cell_neighbours(_cells[pp->index]);
 		for(int c = 0; c < 27; c++) {
-			icell = _neighcells[_cells[pp->index]][c];
+			icell = neighcells[c];
 			//icell = cell_neighbours (_cells[pp->index], c);
 			//assert (icell == _neighcells[_cells[pp->index]][c]);
-			neigh = _vmmc_heads[icell];
+			neigh = _cell_head(icell);
 			while(neigh != P_INVALID) {
 				qq = _particles[neigh];
 
@@ -1141,6 +1145,11 @@ inline number VMMC_CPUBackend::build_cluster_cells(movestr *moveptr, int maxsize
 					continue;
 				}
 
+				if(prune && !_strand_spheres.close(pp->strand_id, qq->strand_id)) {
+					neigh = qq->next_particle;
+					continue;
+				}
+
 				if(qq->inclust == false) {
 					//_r_move_particle (moveptr, pp);
 					//epq_old = _particle_particle_nonbonded_interaction_VMMC (pp, qq, &tmpf_old);
@@ -1247,12 +1256,72 @@ inline void VMMC_CPUBackend::_move_particle(movestr *moveptr, BaseParticle *q, B
 	}
 }
 
+inline int VMMC_CPUBackend::_cell_head(int cell) {
+	if(_sparse_cells) {
+		auto it = _occupied_cells.find(cell);
+		return (it == _occupied_cells.end()) ? P_INVALID : it->second.head;
+	}
+	return _vmmc_heads[cell];
+}
+
+inline const int *VMMC_CPUBackend::_cell_neighbours(int cell) {
+	if(_sparse_cells) {
+		return _occupied_cells.find(cell)->second.neighs;
+	}
+	return _neighcells[cell];
+}
+
+inline void VMMC_CPUBackend::_set_cell_head(int cell, int head) {
+	if(_sparse_cells) {
+		if(head == P_INVALID) {
+			_occupied_cells.erase(cell);
+		}
+		else {
+			auto res = _occupied_cells.emplace(cell, OccupiedCell());
+			if(res.second) {
+				_set_cell_neighbours(cell, res.first->second.neighs);
+			}
+			res.first->second.head = head;
+		}
+		return;
+	}
+
+	if(head == P_INVALID) {
+		if(_vmmc_heads[cell] != P_INVALID) {
+			delete[] _neighcells[cell];
+		}
+	}
+	else if(_vmmc_heads[cell] == P_INVALID) {
+		_neighcells[cell] = new int[27];
+		_set_cell_neighbours(cell, _neighcells[cell]);
+	}
+	_vmmc_heads[cell] = head;
+}
+
+void VMMC_CPUBackend::_set_cell_neighbours(int cell, int *neighs) {
+	int ind[3], loop_ind[3], nneigh = 0;
+	ind[0] = cell % _vmmc_N_cells_side;
+	ind[1] = (cell / _vmmc_N_cells_side) % _vmmc_N_cells_side;
+	ind[2] = cell / (_vmmc_N_cells_side * _vmmc_N_cells_side);
+	for(int j = -1; j < 2; j++) {
+		loop_ind[0] = (ind[0] + j + _vmmc_N_cells_side) % _vmmc_N_cells_side;
+		for(int k = -1; k < 2; k++) {
+			loop_ind[1] = (ind[1] + k + _vmmc_N_cells_side) % _vmmc_N_cells_side;
+			for(int l = -1; l < 2; l++) {
+				loop_ind[2] = (ind[2] + l + _vmmc_N_cells_side) % _vmmc_N_cells_side;
+				neighs[nneigh] = (loop_ind[2] * _vmmc_N_cells_side + loop_ind[1]) * _vmmc_N_cells_side + loop_ind[0];
+				nneigh++;
+			}
+		}
+	}
+}
+
 inline void VMMC_CPUBackend::_fix_list(int p_index, int oldcell, int newcell) {
 	int j, jold;
 
 	// remove p_index from its old cell
 	//printf ("## %i %i %i\n", oldcell, _vmmc_N_cells, _cells[p_index]);
-	j = _vmmc_heads[oldcell];
+	j = _cell_head(oldcell);
 	jold = P_INVALID;
 	assert(j != P_INVALID);
 	while(j != p_index) {
@@ -1267,38 +1336,13 @@ inline void VMMC_CPUBackend::_fix_list(int p_index, int oldcell, int newcell) {
 		_particles[jold]->next_particle = _particles[p_index]->next_particle;
 	}
 	else {
-		_vmmc_heads[oldcell] = _particles[p_index]->next_particle;
-	}
-
-	// the old was full, since it contained the particle; is it now empty?
-	if(_vmmc_heads[oldcell] == P_INVALID) {
-		//printf ("now empty %i\n", oldcell);
-		delete[] _neighcells[oldcell];
-	}
-	if(_vmmc_heads[newcell] == P_INVALID) {
-		//printf ("now filled %i\n", newcell);
-		_neighcells[newcell] = new int[27];
-		int ind[3], loop_ind[3], nneigh = 0;
-		ind[0] = newcell % _vmmc_N_cells_side;
-		ind[1] = (newcell / _vmmc_N_cells_side) % _vmmc_N_cells_side;
-		ind[2] = newcell / (_vmmc_N_cells_side * _vmmc_N_cells_side);
-		for(int jj = -1; jj < 2; jj++) {
-			loop_ind[0] = (ind[0] + jj + _vmmc_N_cells_side) % _vmmc_N_cells_side;
-			for(int kk = -1; kk < 2; kk++) {
-				loop_ind[1] = (ind[1] + kk + _vmmc_N_cells_side) % _vmmc_N_cells_side;
-				for(int ll = -1; ll < 2; ll++) {
-					loop_ind[2] = (ind[2] + ll + _vmmc_N_cells_side) % _vmmc_N_cells_side;
-					int loop_index = (loop_ind[2] * _vmmc_N_cells_side + loop_ind[1]) * _vmmc_N_cells_side + loop_ind[0];
-					_neighcells[newcell][nneigh] = loop_index;
-					nneigh++;
-				}
-			}
-		}
+		// if the old cell is now empty its neighbours are released
+		_set_cell_head(oldcell, _particles[p_index]->next_particle);
 	}
 
 	// add it to the new cell
-	_particles[p_index]->next_particle = _vmmc_heads[newcell];
-	_vmmc_heads[newcell] = p_index;
+	_particles[p_index]->next_particle = _cell_head(newcell);
+	_set_cell_head(newcell, p_index);
 
 	_cells[p_index] = newcell;
 
@@ -1336,6 +1380,10 @@ void VMMC_CPUBackend::sim_step() {
 		}
 		_dU_stack = 0.;
 
+		if(_strand_pruning && !_small_system && !_strand_spheres.is_updated()) {
+			_strand_spheres.update(_box.get());
+		}
+
 		// seed particle;
 		int pi = (int) (drand48() * N());
 		BaseParticle *p = _particles[pi];
@@ -1442,6 +1490,10 @@ void VMMC_CPUBackend::sim_step() {
 					}
 				}
 
+				if(_strand_pruning) {
+					_strand_spheres.check(pp);
+				}
+
 				if(_small_system) {
 					for(int c = 0; c < N(); c++) {
 						qq = _particles[c];
@@ -1597,8 +1649,9 @@ void VMMC_CPUBackend::_update_ops() {
 	number hpq;
 	for(i = 0; i < N(); i++) {
 		p = _particles[i];
+		const int *neighcells = _cell_neighbours(_cells[p->index]);
 		for(c = 0; c < 27; c++) {
-			j = _vmmc_heads[_neighcells[_cells[p->index]][c]];
+			j = _cell_head(neighcells[c]);
 			while(j != P_INVALID) {
 				q = _particles[j];
 				if(j < i && p->n3 != q && p->n5 != q) {
@@ -1697,7 +1750,7 @@ void VMMC_CPUBackend::_compute_energy() {
 	// Since this function is called by MC_CPUBackend::init() but it uses cells initialized
 	// by VMMC_CPUBackend::init(), we do nothing if it's called too early
 
-	if(_vmmc_heads == NULL) {
+	if(_cells == NULL) {
 		return;
 	}
 	BaseParticle * p, *q;
@@ -1721,8 +1774,9 @@ void VMMC_CPUBackend::_compute_energy() {
 				abort();
 			}
 		}
+		const int *neighcells = _cell_neighbours(_cells[p->index]);
 		for(int c = 0; c < 27; c++) {
-			int j = _vmmc_heads[_neighcells[_cells[p->index]][c]];
+			int j = _cell_head(neighcells[c]);
 			while(j != P_INVALID) {
 				q = _particles[j];
 				if(p->n3 != q && p->n5 != q && p->index < q->index) {
@@ -1740,8 +1794,11 @@ void VMMC_CPUBackend::_compute_energy() {
 }
 
 void VMMC_CPUBackend::_init_cells() {
+	// dense grids store two entries per cell, so their size is capped to keep memory usage in check. Sparse grids only
+	// store the occupied cells, and their size is capped only to make sure that cell indices fit in an int
+	int max_N_cells_side = (_sparse_cells) ? (int) cbrt((double) std::numeric_limits<int>::max()) : 750;
 	_vmmc_N_cells_side = (int) (floor(_vmmc_box_side / _rcut) + 0.1);
-	while(_vmmc_N_cells_side > ceil(750.) && _vmmc_N_cells_side > 3) {
+	while(_vmmc_N_cells_side > max_N_cells_side && _vmmc_N_cells_side > 3) {
 		_vmmc_N_cells_side--;
 	}
 
@@ -1750,12 +1807,19 @@ void VMMC_CPUBackend::_init_cells() {
 
 	_vmmc_N_cells = _vmmc_N_cells_side * _vmmc_N_cells_side * _vmmc_N_cells_side;
 
-	_vmmc_heads = new int[_vmmc_N_cells];
 	_cells = new int[N()];
-	_neighcells = new int *[_vmmc_N_cells];
+	if(_sparse_cells) {
+		// there cannot be more occupied cells than particles
+		_occupied_cells.clear();
+		_occupied_cells.reserve(N());
+	}
+	else {
+		_vmmc_heads = new int[_vmmc_N_cells];
+		_neighcells = new int *[_vmmc_N_cells];
 
-	for(int i = 0; i < _vmmc_N_cells; i++)
-		_vmmc_heads[i] = P_INVALID;
+		for(int i = 0; i < _vmmc_N_cells; i++)
+			_vmmc_heads[i] = P_INVALID;
+	}
 
 	for(int i = 0; i < N(); i++) {
 		_particles[i]->next_particle = P_INVALID;
@@ -1764,64 +1828,78 @@ void VMMC_CPUBackend::_init_cells() {
 	for(int i = 0; i < N(); i++) {
 		BaseParticle *p = _particles[i];
 		int cell_index = _get_cell_index(p->pos);
-		int old_head = _vmmc_heads[cell_index];
-		_vmmc_heads[cell_index] = i;
-		_cells[i] = cell_index;
 		assert(cell_index < _vmmc_N_cells);
+		int old_head = _cell_head(cell_index);
+		_set_cell_head(cell_index, i);
+		_cells[i] = cell_index;
 		p->next_particle = old_head;
 	}
 
-	for(int i = 0; i < _vmmc_N_cells; i++) {
-		if(_vmmc_heads[i] != P_INVALID) {
-			_neighcells[i] = new int[27];
-			int ind[3], loop_ind[3], nneigh = 0;
-			ind[0] = i % _vmmc_N_cells_side;
-			ind[1] = (i / _vmmc_N_cells_side) % _vmmc_N_cells_side;
-			ind[2] = i / (_vmmc_N_cells_side * _vmmc_N_cells_side);
-			for(int j = -1; j < 2; j++) {
-				loop_ind[0] = (ind[0] + j + _vmmc_N_cells_side) % _vmmc_N_cells_side;
-				for(int k = -1; k < 2; k++) {
-					loop_ind[1] = (ind[1] + k + _vmmc_N_cells_side) % _vmmc_N_cells_side;
-					for(int l = -1; l < 2; l++) {
-						loop_ind[2] = (ind[2] + l + _vmmc_N_cells_side) % _vmmc_N_cells_side;
-						int loop_index = (loop_ind[2] * _vmmc_N_cells_side + loop_ind[1]) * _vmmc_N_cells_side + loop_ind[0];
-						_neighcells[i][nneigh] = loop_index;
-						nneigh++;
-					}
-				}
+	OX_LOG(Logger::LOG_INFO, "(VMMC_CPUBackend) N_cells_side: %d, sparse: %d", _vmmc_N_cells_side, _sparse_cells);
+}
+
+void VMMC_CPUBackend::_delete_cells() {
+	if(_vmmc_heads != NULL) {
+		for(int i = 0; i < _vmmc_N_cells; i++) {
+			if(_vmmc_heads[i] != P_INVALID) {
+				delete[] _neighcells[i];
 			}
 		}
 	}
+	_occupied_cells.clear();
+	delete[] _vmmc_heads;
+	delete[] _cells;
+	delete[] _neighcells;
+	_vmmc_heads = NULL;
+	_cells = NULL;
+	_neighcells = NULL;
+	return;
+}
 
-	// check for the cells
-	for(int i = 0; i < _vmmc_N_cells; i++) {
-		//fprintf (stderr, "## i %i\n", i);
-		int j = _vmmc_heads[i];
-		//fprintf (stderr, "## j %i\n", j);
-		if(j != P_INVALID) {
-			// fprintf (stderr, "cell %5i: %i ", i, j);
-			j = _particles[j]->next_particle;
-			while(j != P_INVALID) {
-				//fprintf (stderr, "%i ", j);
-				j = _particles[j]->next_particle;
+void VMMC_CPUBackend::_compute_stored_energies() {
+	number tmpf, epq;
+	BaseParticle * p, *q;
+	for(int k = 0; k < N(); k++) {
+		p = _particles[k];
+		if(p->n3 != P_VIRTUAL) {
+			q = p->n3;
+			epq = _particle_particle_bonded_interaction_n3_VMMC(p, q, &tmpf);
+			p->en3 = epq;
+			q->en5 = epq;
+			p->esn3 = tmpf;
+			q->esn5 = tmpf;
+		}
+	}
+
+	if(_small_system) {
+		for(int k = 0; k < N(); k++) {
+			for(int l = 0; l < k; l++) {
+				p = _particles[k];
+				q = _particles[l];
+				if(p->n3 != q && p->n5 != q) {
+					eijm[k][l] = eijm[l][k] = eijm_old[k][l] = eijm_old[l][k] = _particle_particle_nonbonded_interaction_VMMC(p, q, &tmpf);
+					hbijm[k][l] = hbijm[l][k] = hbijm_old[k][l] = hbijm_old[l][k] = (tmpf < HB_CUTOFF);
+				}
 			}
-			// fprintf (stderr, "\n");
 		}
 	}
-	return;
 }
 
-void VMMC_CPUBackend::_delete_cells() {
-	//for (int i = 0; i < _vmmc_N_cells; i ++) delete[] _neighcells[i];
-	for(int i = 0; i < _vmmc_N_cells; i++) {
-		if(_vmmc_heads[i] != P_INVALID) {
-			delete[] _neighcells[i];
-		}
+void VMMC_CPUBackend::recompute_cached_quantities() {
+	// this also recomputes the total energy
+	MC_CPUBackend::recompute_cached_quantities();
+	_compute_stored_energies();
+}
+
+void VMMC_CPUBackend::_on_rcut_update() {
+	MC_CPUBackend::_on_rcut_update();
+
+	// the cells used to build the clusters should be at least as large as the new cutoff
+	_delete_cells();
+	_init_cells();
+	if(_strand_pruning) {
+		_strand_spheres.init(_molecules, _rcut, _strand_pruning_margin);
 	}
-	delete[] _vmmc_heads;
-	delete[] _cells;
-	delete[] _neighcells;
-	return;
 }
 
 void VMMC_CPUBackend::fix_diffusion() {
@@ -1839,6 +1917,7 @@ void VMMC_CPUBackend::fix_diffusion() {
 	_op.reset();
 
 	SimBackend::fix_diffusion();
+	_strand_spheres.invalidate();
 
 	_op.reset();
 	for(int i = 0; i < N(); i++) {
@@ -1872,7 +1951,9 @@ void VMMC_CPUBackend::fix_diffusion() {
 
 void VMMC_CPUBackend::print_observables() {
 	_lists->global_update(true);
-	_backend_info += get_op_state_str();
+	if(_outputs_due()) {
+		_backend_info += get_op_state_str();
+	}
 	MCBackend::print_observables();
 }
 
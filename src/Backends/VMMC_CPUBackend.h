@@ -12,6 +12,10 @@
 #include "../Utilities/Weights.h"
 #include "../Utilities/OrderParameters.h"
 #include "../Utilities/Histogram.h"
+#include "../Lists/StrandBoundingSpheres.h"
+#include "../Boxes/CubicBox.h"
+
+#include <unordered_map>
 
 #define MAX(a,b) (((a)>(b))?(a):(b))
 #define MIN(a,b) (((a)>(b))?(b):(a))
@@ -36,6 +40,9 @@
  [default_weight = <float> (Default: none; mandatory if safe_weights = true; default weight for states that have no specified weight assigned from the weights file)]
  [skip_hist_zeros = <bool> (Default: false; Wether to skip zero entries in the traj_hist file)]
  [equilibration_steps = <int> (Default: 0; number of steps to ignore to allow for equilibration)]
+ [strand_pruning = <bool> (Default: false; whether to use the bounding spheres of the strands to skip the pairs of nucleotides that belong to strands that are far apart when building clusters. Useful in dilute systems)]
+ [strand_pruning_margin = <float> (Default: 1; how much the bounding spheres of the strands are inflated, which sets how far nucleotides can move before they need to be recomputed)]
+ [cells_sparse = <bool> (Default: false; whether to store only the cells that contain nucleotides. Memory usage then scales with the number of nucleotides rather than with the volume of the box, which makes it possible to use cells as small as the cutoff in very large, dilute boxes)]
  @endverbatim
  *
  */
@@ -75,14 +82,41 @@ protected:
 	inline void store_particle(BaseParticle * src);
 	inline void restore_particle(BaseParticle * src);
 
+	bool _strand_pruning;
+	number _strand_pruning_margin;
+	StrandBoundingSpheres _strand_spheres;
+
 	int **_neighcells, *_cells, *_vmmc_heads;
 	int _vmmc_N_cells, _vmmc_N_cells_side;
 	number _vmmc_box_side;
+	/// the box cast to its concrete type if it is cubic (the geometry the VMMC cells are built for), NULL otherwise
+	const CubicBox *_cubic_box;
+
+	/// an occupied cell of the sparse grid: the first particle it contains and the indices of the 27 surrounding cells
+	struct OccupiedCell {
+		int head;
+		int neighs[27];
+	};
+	/// if true, only the occupied cells are stored (in _occupied_cells) and _vmmc_heads and _neighcells are not allocated
+	bool _sparse_cells;
+	std::unordered_map<int, OccupiedCell> _occupied_cells;
 
 	void _create_cells();
 	void _init_cells();
 	void _delete_cells();
+	virtual void _on_rcut_update();
+
+	/**
+	 * @brief Computes the bonded energies stored in the particles and, for small systems, the matrices of the non-bonded energies.
+	 */
+	void _compute_stored_energies();
 	inline void _fix_list(int, int, int);
+	inline int _cell_head(int cell);
+	/// returns the indices of the 27 cells surrounding the given cell, which should contain at least one particle
+	inline const int *_cell_neighbours(int cell);
+	/// sets the first particle of a cell, storing the neighbours of the cell if it was empty and releasing them if the cell becomes empty
+	inline void _set_cell_head(int cell, int head);
+	void _set_cell_neighbours(int cell, int *neighs);
 	inline int _get_cell_index(const LR_vector &pos);
 
 	void _print_pos(int);
@@ -170,6 +204,7 @@ public:
 	void init();
 
 	void sim_step();
+	void recompute_cached_quantities();
 	inline void check_overlaps();
 	inline void check_ops();
 	char * get_op_state_str();
@@ -32,3 +32,13 @@ number BaseBox::sqr_min_image_distance(const BaseParticle &p, const BaseParticle
 number BaseBox::sqr_min_image_distance(const BaseParticle *p, const BaseParticle *q) {
 	return sqr_min_image_distance(p->pos, q->pos);
 }
+
+LR_matrix BaseBox::box_matrix() const {
+	LR_vector sides = box_sides();
+	return LR_matrix(sides.x, 0., 0., 0., sides.y, 0., 0., 0., sides.z);
+}
+
+LR_matrix BaseBox::inverse_box_matrix() const {
+	LR_vector sides = box_sides();
+	return LR_matrix(1. / sides.x, 0., 0., 0., 1. / sides.y, 0., 0., 0., 1. / sides.z);
+}
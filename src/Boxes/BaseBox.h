@@ -18,9 +18,22 @@ class BaseParticle;
  */
 class BaseBox {
 public:
+	/// the geometries that have specialised (non-virtual) implementations of the minimum image convention. See dispatch_box()
+	enum box_geometry {
+		GENERIC = 0,
+		CUBIC,
+		ORTHOGONAL,
+		LEES_EDWARDS,
+		TRICLINIC
+	};
+
 	BaseBox();
 	virtual ~BaseBox();
 
+	box_geometry geometry() const {
+		return _geometry;
+	}
+
 	virtual void get_settings(input_file &inp) = 0;
 	virtual void init(number Lx, number Ly, number Lz) = 0;
 
@@ -75,6 +88,31 @@ public:
 	 */
 	virtual number sqr_min_image_distance(const BaseParticle *p, const BaseParticle *q);
 
+	/**
+	 * @brief Non-virtual version of min_image(const LR_vector &, const LR_vector &).
+	 *
+	 * Boxes that have a specialised geometry hide this method with an inline implementation, which is used by the code
+	 * that obtains the concrete type of the box through dispatch_box(). This generic version just calls the virtual method.
+	 *
+	 * @param v1
+	 * @param v2
+	 * @return
+	 */
+	LR_vector min_image_direct(const LR_vector &v1, const LR_vector &v2) const {
+		return min_image(v1, v2);
+	}
+
+	/**
+	 * @brief Non-virtual version of sqr_min_image_distance(const LR_vector &, const LR_vector &). See min_image_direct().
+	 *
+	 * @param v1
+	 * @param v2
+	 * @return
+	 */
+	number sqr_min_image_distance_direct(const LR_vector &v1, const LR_vector &v2) const {
+		return sqr_min_image_distance(v1, v2);
+	}
+
 	/**
 	 * @brief Brings back v in the box and returns its normalised components.
 	 *
@@ -90,6 +128,32 @@ public:
 	 */
 	virtual LR_vector box_sides() const = 0;
 
+	/**
+	 * @brief Returns the matrix whose columns are the three box vectors, so that box_matrix() * s is the position
+	 * corresponding to the fractional coordinates s.
+	 *
+	 * The default implementation returns a diagonal matrix built out of box_sides().
+	 *
+	 * @return
+	 */
+	virtual LR_matrix box_matrix() const;
+
+	/**
+	 * @brief Returns the inverse of box_matrix(), which maps positions onto fractional coordinates.
+	 *
+	 * @return
+	 */
+	virtual LR_matrix inverse_box_matrix() const;
+
+	/**
+	 * @brief Returns the distances between opposite faces of the box. For orthogonal boxes these are the box sides.
+	 *
+	 * @return
+	 */
+	virtual LR_vector perpendicular_widths() const {
+		return box_sides();
+	}
+
 	/**
 	 * @brief Returns the box's total volume.
 	 *
@@ -112,8 +176,9 @@ public:
 	 */
 	virtual void shift_particle(BaseParticle *p, LR_vector &amount) = 0;
 
-	const std::string INIT_EVENT = "box_initialised";
-	const std::string UPDATE_EVENT = "box_updated";
+protected:
+	/// set by the boxes that have a specialised implementation. Classes that inherit from them and change the minimum image convention should set it back to GENERIC
+	box_geometry _geometry = GENERIC;
 };
 
 using BoxPtr = std::shared_ptr<BaseBox>;
@@ -0,0 +1,45 @@
+/*
+ * BoxDispatch.h
+ */
+
+#ifndef BOXDISPATCH_H_
+#define BOXDISPATCH_H_
+
+#include "CubicBox.h"
+#include "OrthogonalBox.h"
+#include "LeesEdwardsCubicBox.h"
+#include "TriclinicBox.h"
+
+/**
+ * @brief Invokes f with a pointer to the box cast to its concrete type.
+ *
+ * This makes it possible to write hot loops as generic lambdas (or templates) that call the box's min_image_direct()
+ * and sqr_min_image_distance_direct() methods, which are then resolved at compile time and can be inlined. The
+ * dispatch should be done once per loop rather than once per pair. Boxes whose geometry is not known (e.g. those
+ * defined in plugins) are passed as BaseBox pointers, whose "direct" methods fall back to the virtual ones.
+ *
+ * @param box
+ * @param f a callable that accepts a pointer to any of the box types
+ */
+template<typename F>
+inline void dispatch_box(const BaseBox *box, F &&f) {
+	switch(box->geometry()) {
+	case BaseBox::CUBIC:
+		f(static_cast<const CubicBox *>(box));
+		break;
+	case BaseBox::ORTHOGONAL:
+		f(static_cast<const OrthogonalBox *>(box));
+		break;
+	case BaseBox::LEES_EDWARDS:
+		f(static_cast<const LeesEdwardsCubicBox *>(box));
+		break;
+	case BaseBox::TRICLINIC:
+		f(static_cast<const TriclinicBox *>(box));
+		break;
+	default:
+		f(box);
+		break;
+	}
+}
+
+#endif /* BOXDISPATCH_H_ */
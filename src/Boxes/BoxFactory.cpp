@@ -10,6 +10,7 @@
 #include "CubicBox.h"
 #include "OrthogonalBox.h"
 #include "LeesEdwardsCubicBox.h"
+#include "TriclinicBox.h"
 
 #include "../Utilities/oxDNAException.h"
 
@@ -28,5 +29,9 @@ BoxPtr BoxFactory::make_box(input_file &inp) {
 		if(!lees_edwards) return std::make_shared<OrthogonalBox>();
 		else throw oxDNAException("Lees-Edwards boundary conditions and orthogonal boxes are not compatible");
 	}
+	else if(!strncmp(box_type, "triclinic", 512)) {
+		if(!lees_edwards) return std::make_shared<TriclinicBox>();
+		else throw oxDNAException("Lees-Edwards boundary conditions and triclinic boxes are not compatible");
+	}
 	else throw oxDNAException("Unsupported box '%s'", box_type);
 }
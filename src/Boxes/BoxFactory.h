@@ -14,7 +14,7 @@
  * @brief Static factory class. Its only public method builds a {@link BaseBox}.
  *
  * @verbatim
- [list_type = cubic (Type of simulation box for CPU simulations.)]
+ [box_type = cubic (Type of simulation box for CPU simulations. Can be cubic, orthogonal or triclinic.)]
  @endverbatim
  */
 class BoxFactory {
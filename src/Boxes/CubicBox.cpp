@@ -17,6 +17,8 @@ using namespace std;
 
 CubicBox::CubicBox() {
 	_side = -1.0;
+	_inv_side = -1.0;
+	_geometry = CUBIC;
 }
 
 CubicBox::~CubicBox() {
@@ -31,16 +33,17 @@ void CubicBox::init(number Lx, number Ly, number Lz) {
 	if(Lx != Ly || Ly != Lz || Lz != Lx) throw oxDNAException("The box in the configuration file is not cubic (%f %f %f). Non-cubic boxes can be used by adding a 'box_type = orthogonal' option.", Lx, Ly, Lz);
 
 	_side = Lx;
+	_inv_side = 1. / Lx;
 	_sides.x = _sides.y = _sides.z = Lx;
 
-	CONFIG_INFO->notify(INIT_EVENT);
+	CONFIG_INFO->notify(ConfigInfo::BOX_INITIALISED);
 }
 
 LR_vector CubicBox::normalised_in_box(const LR_vector &v) {
 	return LR_vector(
-		(v.x / _side - floor(v.x / _side)) * (1.f - std::numeric_limits<number>::epsilon()),
-		(v.y / _side - floor(v.y / _side)) * (1.f - std::numeric_limits<number>::epsilon()),
-		(v.z / _side - floor(v.z / _side)) * (1.f - std::numeric_limits<number>::epsilon())
+		(v.x * _inv_side - floor(v.x * _inv_side)) * (1.f - std::numeric_limits<number>::epsilon()),
+		(v.y * _inv_side - floor(v.y * _inv_side)) * (1.f - std::numeric_limits<number>::epsilon()),
+		(v.z * _inv_side - floor(v.z * _inv_side)) * (1.f - std::numeric_limits<number>::epsilon())
 	);
 }
 
@@ -48,16 +51,12 @@ LR_vector CubicBox::box_sides() const {
 	return _sides;
 }
 
-inline LR_vector CubicBox::min_image(const LR_vector &v1, const LR_vector &v2) const {
-	return LR_vector(
-		v2.x - v1.x - rint((v2.x - v1.x) / _side) * _side,
-		v2.y - v1.y - rint((v2.y - v1.y) / _side) * _side,
-		v2.z - v1.z - rint((v2.z - v1.z) / _side) * _side
-	);
+LR_vector CubicBox::min_image(const LR_vector &v1, const LR_vector &v2) const {
+	return min_image_direct(v1, v2);
 }
 
 number CubicBox::sqr_min_image_distance(const LR_vector &v1, const LR_vector &v2) const {
-	return min_image(v1, v2).norm();
+	return min_image_direct(v1, v2).norm();
 }
 
 LR_vector CubicBox::get_abs_pos(BaseParticle *p) {
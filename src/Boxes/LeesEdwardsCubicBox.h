@@ -13,7 +13,11 @@
 
 class LeesEdwardsCubicBox: public CubicBox {
 protected:
+	number _shear_rate_dt;
+	/// shift between the periodic images along y accumulated in a time step (shear rate * Ly * dt)
 	number _factor;
+	/// pointer to the current step, which sets the shift between the periodic images along y
+	const llint *_curr_step = nullptr;
 
 public:
 	LeesEdwardsCubicBox();
@@ -25,6 +29,20 @@ public:
 	virtual LR_vector min_image(const LR_vector &v1, const LR_vector &v2) const;
 	virtual number sqr_min_image_distance(const LR_vector &v1, const LR_vector &v2) const;
 
+	LR_vector min_image_direct(const LR_vector &v1, const LR_vector &v2) const {
+		number delta_x = _factor * *_curr_step;
+
+		number ny = v2.y - v1.y;
+		number cy = rint(ny * _inv_side);
+		number nx = v2.x - v1.x - cy * delta_x;
+
+		return LR_vector(nx - rint(nx * _inv_side) * _side, ny - cy * _side, v2.z - v1.z - rint((v2.z - v1.z) * _inv_side) * _side);
+	}
+
+	number sqr_min_image_distance_direct(const LR_vector &v1, const LR_vector &v2) const {
+		return min_image_direct(v1, v2).norm();
+	}
+
 //	virtual void shift_particle (BaseParticle *p, LR_vector &amount);
 };
 
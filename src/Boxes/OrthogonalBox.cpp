@@ -16,6 +16,7 @@ using namespace std;
 
 OrthogonalBox::OrthogonalBox() :
 				BaseBox() {
+	_geometry = ORTHOGONAL;
 
 }
 
@@ -31,12 +32,13 @@ void OrthogonalBox::init(number Lx, number Ly, number Lz) {
 	_sides.x = Lx;
 	_sides.y = Ly;
 	_sides.z = Lz;
+	_inv_sides = LR_vector(1. / Lx, 1. / Ly, 1. / Lz);
 
-	CONFIG_INFO->notify(INIT_EVENT);
+	CONFIG_INFO->notify(ConfigInfo::BOX_INITIALISED);
 }
 
 LR_vector OrthogonalBox::normalised_in_box(const LR_vector &v) {
-	return LR_vector((v.x / _sides.x - floor(v.x / _sides.x)) * (1.f - std::numeric_limits<number>::epsilon()), (v.y / _sides.y - floor(v.y / _sides.y)) * (1.f - std::numeric_limits<number>::epsilon()), (v.z / _sides.z - floor(v.z / _sides.z)) * (1.f - std::numeric_limits<number>::epsilon()));
+	return LR_vector((v.x * _inv_sides.x - floor(v.x * _inv_sides.x)) * (1.f - std::numeric_limits<number>::epsilon()), (v.y * _inv_sides.y - floor(v.y * _inv_sides.y)) * (1.f - std::numeric_limits<number>::epsilon()), (v.z * _inv_sides.z - floor(v.z * _inv_sides.z)) * (1.f - std::numeric_limits<number>::epsilon()));
 }
 
 LR_vector OrthogonalBox::box_sides() const {
@@ -44,19 +46,11 @@ LR_vector OrthogonalBox::box_sides() const {
 }
 
 LR_vector OrthogonalBox::min_image(const LR_vector &v1, const LR_vector &v2) const {
-	return LR_vector(v2.x - v1.x - rint((v2.x - v1.x) / _sides.x) * _sides.x, v2.y - v1.y - rint((v2.y - v1.y) / _sides.y) * _sides.y, v2.z - v1.z - rint((v2.z - v1.z) / _sides.z) * _sides.z);
+	return min_image_direct(v1, v2);
 }
 
 number OrthogonalBox::sqr_min_image_distance(const LR_vector &v1, const LR_vector &v2) const {
-	number nx = v2.x - v1.x;
-	number ny = v2.y - v1.y;
-	number nz = v2.z - v1.z;
-
-	nx -= rint(nx / _sides.x) * _sides.x;
-	ny -= rint(ny / _sides.y) * _sides.y;
-	nz -= rint(nz / _sides.z) * _sides.z;
-
-	return nx * nx + ny * ny + nz * nz;
+	return min_image_direct(v1, v2).norm();
 }
 
 LR_vector OrthogonalBox::get_abs_pos(BaseParticle * p) {
@@ -17,6 +17,7 @@
 class OrthogonalBox: public BaseBox {
 protected:
 	LR_vector _sides;
+	LR_vector _inv_sides;
 
 public:
 	OrthogonalBox();
@@ -28,6 +29,18 @@ public:
 	virtual LR_vector min_image(const LR_vector &v1, const LR_vector &v2) const;
 	virtual number sqr_min_image_distance(const LR_vector &v1, const LR_vector &v2) const;
 
+	LR_vector min_image_direct(const LR_vector &v1, const LR_vector &v2) const {
+		return LR_vector(
+			v2.x - v1.x - rint((v2.x - v1.x) * _inv_sides.x) * _sides.x,
+			v2.y - v1.y - rint((v2.y - v1.y) * _inv_sides.y) * _sides.y,
+			v2.z - v1.z - rint((v2.z - v1.z) * _inv_sides.z) * _sides.z
+		);
+	}
+
+	number sqr_min_image_distance_direct(const LR_vector &v1, const LR_vector &v2) const {
+		return min_image_direct(v1, v2).norm();
+	}
+
 	virtual LR_vector normalised_in_box(const LR_vector &v);
 	LR_vector box_sides() const override;
 	virtual number V() { return _sides.x*_sides.y*_sides.z; }
@@ -0,0 +1,124 @@
+/*
+ * TriclinicBox.cpp
+ */
+
+#include "TriclinicBox.h"
+
+#include "../Utilities/Utils.h"
+#include "../Utilities/ConfigInfo.h"
+#include "../Particles/BaseParticle.h"
+
+#include <limits>
+
+using namespace std;
+
+TriclinicBox::TriclinicBox() :
+				BaseBox() {
+	_geometry = TRICLINIC;
+}
+
+TriclinicBox::~TriclinicBox() {
+
+}
+
+void TriclinicBox::get_settings(input_file &inp) {
+	std::string tilts;
+	if(getInputString(&inp, "box_tilts", tilts, 0) == KEY_FOUND) {
+		auto fields = Utils::split(tilts, ',');
+		if(fields.size() != 3) {
+			throw oxDNAException("box_tilts should contain three comma-separated numbers (xy, xz and yz), found '%s'", tilts.c_str());
+		}
+		_xy = stod(fields[0]);
+		_xz = stod(fields[1]);
+		_yz = stod(fields[2]);
+	}
+}
+
+bool TriclinicBox::is_valid(number Lx, number Ly, number Lz, number xy, number xz, number yz) {
+	if(Lx <= 0. || Ly <= 0. || Lz <= 0.) {
+		return false;
+	}
+	// a tiny tolerance makes it possible to use tilts that are exactly equal to half of the side
+	number tolerance = 1. + 10. * std::numeric_limits<number>::epsilon();
+	return fabs(xy) <= 0.5 * Lx * tolerance && fabs(xz) <= 0.5 * Lx * tolerance && fabs(yz) <= 0.5 * Ly * tolerance;
+}
+
+void TriclinicBox::init(number Lx, number Ly, number Lz) {
+	if(!_initialised) {
+		init(Lx, Ly, Lz, _xy, _xz, _yz);
+	}
+	else {
+		// deform the box along the Cartesian axes: each tilt factor follows the side that shares its row of the box matrix
+		number fx = Lx / _sides.x;
+		number fy = Ly / _sides.y;
+		init(Lx, Ly, Lz, _xy * fx, _xz * fx, _yz * fy);
+	}
+}
+
+void TriclinicBox::init(number Lx, number Ly, number Lz, number xy, number xz, number yz) {
+	if(!is_valid(Lx, Ly, Lz, xy, xz, yz)) {
+		throw oxDNAException("Invalid triclinic box (sides: %lf %lf %lf, tilts: %lf %lf %lf): the sides should be positive and the tilts should satisfy |xy| <= Lx/2, |xz| <= Lx/2 and |yz| <= Ly/2", Lx, Ly, Lz, xy, xz, yz);
+	}
+
+	_sides = LR_vector(Lx, Ly, Lz);
+	_inv_sides = LR_vector(1. / Lx, 1. / Ly, 1. / Lz);
+	_xy = xy;
+	_xz = xz;
+	_yz = yz;
+
+	_inv_xy = -xy / (Lx * Ly);
+	_inv_xz = (xy * yz - xz * Ly) / (Lx * Ly * Lz);
+	_inv_yz = -yz / (Ly * Lz);
+
+	_initialised = true;
+
+	CONFIG_INFO->notify(ConfigInfo::BOX_INITIALISED);
+}
+
+LR_vector TriclinicBox::normalised_in_box(const LR_vector &v) {
+	LR_vector s = fractional(v);
+	return LR_vector((s.x - floor(s.x)) * (1.f - std::numeric_limits<number>::epsilon()), (s.y - floor(s.y)) * (1.f - std::numeric_limits<number>::epsilon()), (s.z - floor(s.z)) * (1.f - std::numeric_limits<number>::epsilon()));
+}
+
+LR_vector TriclinicBox::box_sides() const {
+	return _sides;
+}
+
+LR_matrix TriclinicBox::box_matrix() const {
+	return LR_matrix(_sides.x, _xy, _xz, 0., _sides.y, _yz, 0., 0., _sides.z);
+}
+
+LR_matrix TriclinicBox::inverse_box_matrix() const {
+	return LR_matrix(_inv_sides.x, _inv_xy, _inv_xz, 0., _inv_sides.y, _inv_yz, 0., 0., _inv_sides.z);
+}
+
+LR_vector TriclinicBox::perpendicular_widths() const {
+	// the width along each box vector is the volume divided by the area of the face spanned by the other two vectors
+	LR_vector a(_sides.x, 0., 0.);
+	LR_vector b(_xy, _sides.y, 0.);
+	LR_vector c(_xz, _yz, _sides.z);
+	number V = _sides.x * _sides.y * _sides.z;
+
+	return LR_vector(V / b.cross(c).module(), V / c.cross(a).module(), V / a.cross(b).module());
+}
+
+LR_vector TriclinicBox::min_image(const LR_vector &v1, const LR_vector &v2) const {
+	return min_image_direct(v1, v2);
+}
+
+number TriclinicBox::sqr_min_image_distance(const LR_vector &v1, const LR_vector &v2) const {
+	return min_image_direct(v1, v2).norm();
+}
+
+LR_vector TriclinicBox::get_abs_pos(BaseParticle *p) {
+	return p->pos + cartesian(LR_vector((number) p->_pos_shift[0], (number) p->_pos_shift[1], (number) p->_pos_shift[2]));
+}
+
+void TriclinicBox::shift_particle(BaseParticle *p, LR_vector &amount) {
+	LR_vector s = fractional(amount);
+	LR_vector n(floor(s.x), floor(s.y), floor(s.z));
+	p->_pos_shift[0] += (int) n.x;
+	p->_pos_shift[1] += (int) n.y;
+	p->_pos_shift[2] += (int) n.z;
+	p->pos -= cartesian(n);
+}
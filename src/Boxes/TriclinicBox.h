@@ -0,0 +1,131 @@
+/*
+ * TriclinicBox.h
+ */
+
+#ifndef TRICLINICBOX_H_
+#define TRICLINICBOX_H_
+
+#include "BaseBox.h"
+
+/**
+ * @brief A general periodic (triclinic) simulation box.
+ *
+ * The box is defined by the three vectors a = (Lx, 0, 0), b = (xy, Ly, 0) and c = (xz, yz, Lz), where xy, xz and yz
+ * are the tilt factors. With this choice the box matrix (whose columns are the box vectors) is upper triangular, so that
+ * fractional coordinates can be computed by back-substitution and the minimum image convention can be applied one
+ * axis at a time, starting from z. The tilt factors are limited to half of the corresponding side (|xy|, |xz| <= Lx/2
+ * and |yz| <= Ly/2): within these bounds the minimum image is exact for all distances shorter than half of the
+ * smallest perpendicular width of the box.
+ *
+ * The tilt factors can be set in the input file or in the header of the configuration file, whose box line can
+ * contain six numbers: "b = Lx Ly Lz xy xz yz". Calling init(Lx, Ly, Lz) on a box that has already been initialised
+ * deforms the box along the three Cartesian axes: the tilt factors are rescaled together with the side that shares
+ * their row in the box matrix (xy and xz with Lx, yz with Ly), which is the transformation applied by the volume moves.
+ *
+ * @verbatim
+[box_tilts = <float>, <float>, <float> (the xy, xz and yz tilt factors used if box_type = triclinic and the configuration file does not specify them. Defaults to 0, 0, 0)]
+@endverbatim
+ */
+class TriclinicBox: public BaseBox {
+protected:
+	LR_vector _sides;
+	LR_vector _inv_sides;
+	number _xy = 0.;
+	number _xz = 0.;
+	number _yz = 0.;
+	bool _initialised = false;
+
+	/// the three off-diagonal elements of the (upper-triangular) inverse box matrix
+	number _inv_xy = 0.;
+	number _inv_xz = 0.;
+	number _inv_yz = 0.;
+
+public:
+	TriclinicBox();
+	virtual ~TriclinicBox();
+
+	virtual void get_settings(input_file &inp);
+	virtual void init(number Lx, number Ly, number Lz);
+
+	/**
+	 * @brief Initialises the box with the given sides and tilt factors.
+	 *
+	 * @param Lx
+	 * @param Ly
+	 * @param Lz
+	 * @param xy
+	 * @param xz
+	 * @param yz
+	 */
+	void init(number Lx, number Ly, number Lz, number xy, number xz, number yz);
+
+	/**
+	 * @brief Returns true if the given sides and tilt factors describe a valid box. See the class description.
+	 */
+	static bool is_valid(number Lx, number Ly, number Lz, number xy, number xz, number yz);
+
+	/**
+	 * @brief Returns the tilt factors as a (xy, xz, yz) vector.
+	 */
+	LR_vector tilts() const {
+		return LR_vector(_xy, _xz, _yz);
+	}
+
+	virtual LR_vector min_image(const LR_vector &v1, const LR_vector &v2) const;
+	virtual number sqr_min_image_distance(const LR_vector &v1, const LR_vector &v2) const;
+
+	LR_vector min_image_direct(const LR_vector &v1, const LR_vector &v2) const {
+		LR_vector d = v2 - v1;
+
+		number n = rint(d.z * _inv_sides.z);
+		d.x -= n * _xz;
+		d.y -= n * _yz;
+		d.z -= n * _sides.z;
+
+		n = rint(d.y * _inv_sides.y);
+		d.x -= n * _xy;
+		d.y -= n * _sides.y;
+
+		d.x -= rint(d.x * _inv_sides.x) * _sides.x;
+
+		return d;
+	}
+
+	number sqr_min_image_distance_direct(const LR_vector &v1, const LR_vector &v2) const {
+		return min_image_direct(v1, v2).norm();
+	}
+
+	/**
+	 * @brief Returns the fractional coordinates of the given position.
+	 *
+	 * @param v
+	 * @return
+	 */
+	LR_vector fractional(const LR_vector &v) const {
+		return LR_vector(v.x * _inv_sides.x + v.y * _inv_xy + v.z * _inv_xz, v.y * _inv_sides.y + v.z * _inv_yz, v.z * _inv_sides.z);
+	}
+
+	/**
+	 * @brief Returns the position corresponding to the given fractional coordinates.
+	 *
+	 * @param s
+	 * @return
+	 */
+	LR_vector cartesian(const LR_vector &s) const {
+		return LR_vector(s.x * _sides.x + s.y * _xy + s.z * _xz, s.y * _sides.y + s.z * _yz, s.z * _sides.z);
+	}
+
+	virtual LR_vector normalised_in_box(const LR_vector &v);
+	LR_vector box_sides() const override;
+	LR_matrix box_matrix() const override;
+	LR_matrix inverse_box_matrix() const override;
+	LR_vector perpendicular_widths() const override;
+	virtual number V() {
+		return _sides.x * _sides.y * _sides.z;
+	}
+
+	virtual LR_vector get_abs_pos(BaseParticle *p);
+	virtual void shift_particle(BaseParticle *p, LR_vector &amount);
+};
+
+#endif /* TRICLINICBOX_H_ */
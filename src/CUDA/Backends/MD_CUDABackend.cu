@@ -304,6 +304,11 @@ void MD_CUDABackend::apply_changes_to_simulation_data() {
 	_cuda_interaction->sync_GPU();
 }
 
+void MD_CUDABackend::get_metrics(std::vector<std::pair<std::string, number>> &metrics) {
+	// energies and velocities live on the GPU and retrieving them would require a costly synchronisation
+	SimBackend::get_metrics(metrics);
+}
+
 void MD_CUDABackend::apply_simulation_data_changes() {
 	_gpu_to_host();
 
@@ -484,7 +489,7 @@ void MD_CUDABackend::_apply_barostat() {
 	// accepted
 	if(acc > drand48()) {
 		_barostat_accepted++;
-		CONFIG_INFO->notify(CONFIG_INFO->box->UPDATE_EVENT);
+		CONFIG_INFO->notify_deferred(ConfigInfo::BOX_UPDATED);
 	}
 	// rejected
 	else {
@@ -92,6 +92,8 @@ public:
 
 	virtual void apply_simulation_data_changes();
 	virtual void apply_changes_to_simulation_data();
+
+	virtual void get_metrics(std::vector<std::pair<std::string, number>> &metrics);
 };
 
 #endif /* MD_CUDABACKEND_H_ */
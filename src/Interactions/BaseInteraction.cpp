@@ -7,6 +7,8 @@
 
 #include "BaseInteraction.h"
 
+#include <chrono>
+
 BaseInteraction::BaseInteraction() {
 	_energy_threshold = (number) 100.f;
 	_is_infinite = false;
@@ -102,7 +104,9 @@ void BaseInteraction::read_topology(int *N_strands, std::vector<BaseParticle *>
 }
 
 void BaseInteraction::begin_energy_computation() {
-
+	for(auto &derivative : _parameter_derivatives) {
+		derivative.second = (number) 0.f;
+	}
 }
 
 void BaseInteraction::begin_energy_and_force_computation() {
@@ -211,6 +215,35 @@ StressTensor BaseInteraction::stress_tensor() const {
 	return norm_st;
 }
 
+number BaseInteraction::pair_interaction_nonbonded_block(BaseParticle *p, const std::vector<BaseParticle *> &neighs, bool update_forces) {
+	if(_neighbour_block_kernel) {
+		return _neighbour_block_kernel(p, neighs, update_forces);
+	}
+
+	number energy = (number) 0.f;
+	for(auto q : neighs) {
+		energy += pair_interaction_nonbonded(p, q, true, update_forces);
+	}
+
+	return energy;
+}
+
+number BaseInteraction::pair_interaction_nonbonded_energy_block(BaseParticle *p, const std::vector<BaseParticle *> &neighs) {
+	if(_energy_block_kernel) {
+		return _energy_block_kernel(p, neighs);
+	}
+
+	number energy = (number) 0.f;
+	for(auto q : neighs) {
+		energy += pair_interaction_nonbonded(p, q);
+		if(get_is_infinite()) {
+			return energy;
+		}
+	}
+
+	return energy;
+}
+
 number BaseInteraction::get_system_energy(std::vector<BaseParticle *> &particles, BaseList *lists) {
 	begin_energy_computation();
 
@@ -271,6 +304,12 @@ void BaseInteraction::generate_random_configuration(std::vector<BaseParticle *>
 
 	c.global_update();
 
+	auto start = std::chrono::steady_clock::now();
+	auto elapsed = [&start]() {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	};
+	llint attempts = 0;
+
 	int N = particles.size();
 	for(int i = 0; i < N; i++) {
 		BaseParticle *p = particles[i];
@@ -278,6 +317,12 @@ void BaseInteraction::generate_random_configuration(std::vector<BaseParticle *>
 
 		bool inserted = false;
 		do {
+			// checking the clock at each attempt would be too expensive
+			attempts++;
+			if(_generate_time_budget > 0. && attempts % 1000 == 0 && elapsed() > _generate_time_budget) {
+				throw oxDNAException("The generation of the initial configuration exceeded the time budget of %g seconds after inserting %d particles out of %d (%lld insertion attempts). Try with a lower density or with generator_mode = lattice", _generate_time_budget, i, N, attempts);
+			}
+
 			if(same_strand) {
 				p->pos = particles[i - 1]->pos + LR_vector((drand48() - 0.5), (drand48() - 0.5), (drand48() - 0.5)) * _generate_bonded_cutoff;
 			}
@@ -322,6 +367,6 @@ void BaseInteraction::generate_random_configuration(std::vector<BaseParticle *>
 
 		} while(!inserted);
 
-		if(i > 0 && N > 10 && i % (N / 10) == 0) OX_LOG(Logger::LOG_INFO, "Inserted %d%% of the particles (%d/%d)", i*100/N, i, N);
+		if(i > 0 && N > 10 && i % (N / 10) == 0) OX_LOG(Logger::LOG_INFO, "Inserted %d%% of the particles (%d/%d) in %.1lf seconds", i*100/N, i, N, elapsed());
 	}
 }
@@ -42,6 +42,8 @@ protected:
 	bool _generate_consider_bonded_interactions;
 	/// This controls the maximum at which bonded neighbours should be randomly placed to speed-up generation. Used by generator functions.
 	number _generate_bonded_cutoff;
+	/// Maximum time (in seconds) the generation of the initial configuration can take. If 0, there is no limit
+	double _generate_time_budget = 0.;
 
 	number _rcut, _sqr_rcut;
 
@@ -51,12 +53,25 @@ protected:
 
 	StressTensor _stress_tensor;
 
+	/// derivatives of the energy with respect to the model parameters, accumulated only by the interactions that support them
+	std::map<std::string, number> _parameter_derivatives;
+
 	virtual void _update_stress_tensor(const LR_vector &r_p, const LR_vector &group_force);
 
 	using energy_function = std::function<number(BaseParticle *, BaseParticle *, bool, bool)>;
 	using interaction_map = std::map<int, energy_function>;
 	interaction_map _interaction_map;
 
+public:
+	/// Kernel that computes the non-bonded interaction between a particle and a block of its neighbours, optionally updating forces and torques
+	using neighbour_block_kernel = std::function<number(BaseParticle *, const std::vector<BaseParticle *> &, bool)>;
+	/// Kernel that computes the non-bonded energy between a particle and a block of its neighbours
+	using energy_block_kernel = std::function<number(BaseParticle *, const std::vector<BaseParticle *> &)>;
+
+protected:
+	neighbour_block_kernel _neighbour_block_kernel;
+	energy_block_kernel _energy_block_kernel;
+
 public:
 	/**
 	 * @brief Basic constructor. By default, it does not need anything.
@@ -176,6 +191,56 @@ public:
 	 */
 	virtual number pair_interaction_nonbonded(BaseParticle *p, BaseParticle *q, bool compute_r = true, bool update_forces = false) = 0;
 
+	/**
+	 * @brief Registers a kernel that computes the non-bonded interaction between a particle and a whole block of neighbours.
+	 *
+	 * The kernel should return the same energy, and update forces and torques in the same way, as a sequence of
+	 * pair_interaction_nonbonded() calls. Backends use it in their force loops if it has been registered, and fall back to per-pair calls otherwise.
+	 *
+	 * @param kernel
+	 */
+	void register_neighbour_block_kernel(neighbour_block_kernel kernel) {
+		_neighbour_block_kernel = kernel;
+	}
+
+	/**
+	 * @brief Registers a kernel that computes the non-bonded energy between a particle and a whole block of neighbours. Forces are never updated.
+	 *
+	 * @param kernel
+	 */
+	void register_energy_block_kernel(energy_block_kernel kernel) {
+		_energy_block_kernel = kernel;
+	}
+
+	bool has_neighbour_block_kernel() const {
+		return (bool) _neighbour_block_kernel;
+	}
+
+	bool has_energy_block_kernel() const {
+		return (bool) _energy_block_kernel;
+	}
+
+	/**
+	 * @brief Computes the non-bonded interaction between p and all the given neighbours, using the registered kernel if there is one.
+	 *
+	 * @param p
+	 * @param neighs
+	 * @param update_forces
+	 * @return the sum of the pair energies
+	 */
+	number pair_interaction_nonbonded_block(BaseParticle *p, const std::vector<BaseParticle *> &neighs, bool update_forces = false);
+
+	/**
+	 * @brief Computes the non-bonded energy between p and all the given neighbours, using the registered kernel if there is one.
+	 *
+	 * Without a kernel, the computation stops as soon as an overlap is found.
+	 *
+	 * @param p
+	 * @param neighs
+	 * @return the sum of the pair energies
+	 */
+	number pair_interaction_nonbonded_energy_block(BaseParticle *p, const std::vector<BaseParticle *> &neighs);
+
 	/**
 	 * @brief Computes the requested term of the interaction energy between p and q.
 	 *
@@ -228,6 +293,35 @@ public:
 	 */
 	virtual int get_N_from_topology();
 
+	/**
+	 * @brief Returns an estimate of the memory used by the interaction's internal data structures (e.g. meshes), in bytes.
+	 *
+	 * The default implementation returns 0.
+	 */
+	virtual llint memory_footprint() {
+		return 0;
+	}
+
+	/**
+	 * @brief Returns the derivatives of the potential energy with respect to the model parameters, accumulated since the last call to begin_energy_computation().
+	 *
+	 * The map is empty unless the interaction supports this feature and has been asked to compute the derivatives.
+	 */
+	const std::map<std::string, number> &get_parameter_derivatives() const {
+		return _parameter_derivatives;
+	}
+
+	/**
+	 * @brief Returns the ids of the energy terms that can be computed separately through pair_interaction_term().
+	 */
+	std::vector<int> get_term_ids() {
+		std::vector<int> ids;
+		for(auto &term : _interaction_map) {
+			ids.push_back(term.first);
+		}
+		return ids;
+	}
+
 	/**
 	 * @brief Returns the state of the interaction
 	 */
@@ -277,6 +371,10 @@ public:
 	 * @param N
 	 */
 	virtual void generate_random_configuration(std::vector<BaseParticle *> &particles);
+
+	void set_generate_time_budget(double budget) {
+		_generate_time_budget = budget;
+	}
 };
 
 using InteractionPtr = std::shared_ptr<BaseInteraction>;
@@ -112,6 +112,10 @@ void CustomInteraction::init() {
 	OX_LOG(Logger::LOG_INFO, "custom: rcut = %lf, Ecut = %lf", _rcut, _Ecut);
 }
 
+llint CustomInteraction::memory_footprint() {
+	return _non_bonded_mesh.memory_footprint() + _bonded_mesh.memory_footprint();
+}
+
 void CustomInteraction::allocate_particles(std::vector<BaseParticle *> &particles) {
 	for(uint i = 0; i < particles.size(); i++) {
 		particles[i] = new CustomParticle();
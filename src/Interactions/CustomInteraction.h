@@ -70,6 +70,8 @@ public:
 	virtual void get_settings(input_file &inp);
 	virtual void init();
 
+	virtual llint memory_footprint();
+
 	virtual void allocate_particles(std::vector<BaseParticle *> &particles);
 	virtual void read_topology(int *N_strands, std::vector<BaseParticle *> &particles);
 
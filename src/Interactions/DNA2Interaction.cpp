@@ -1,5 +1,6 @@
 #include "DNA2Interaction.h"
 
+#include "InteractionUtils.h"
 #include "../Particles/DNANucleotide.h"
 
 DNA2Interaction::DNA2Interaction() :
@@ -16,6 +17,9 @@ DNA2Interaction::DNA2Interaction() :
 
 	_salt_concentration = 0.5;
 	_debye_huckel_half_charged_ends = true;
+	_debye_huckel_rhigh_fixed = false;
+	_compute_parameter_derivatives = false;
+	_salt_derivative = nullptr;
 	_grooving = true;
 	_fene_r0 = FENE_R0_OXDNA2;
 }
@@ -34,7 +38,13 @@ number DNA2Interaction::pair_interaction_bonded(BaseParticle *p, BaseParticle *q
 	// other one belongs to DNA2Interaction
 	number energy = _backbone(p, q, false, update_forces);
 	energy += _bonded_excluded_volume(p, q, false, update_forces);
-	energy += _stacking(p, q, false, update_forces);
+	number stacking_energy = _stacking(p, q, false, update_forces);
+	energy += stacking_energy;
+
+	// the stacking energy is proportional to the well depth
+	if(_compute_parameter_derivatives && stacking_energy != (number) 0.f) {
+		*_stacking_derivatives[q->type][p->type] += stacking_energy / F1_EPS[STCK_F1][q->type][p->type];
+	}
 
 	return energy;
 }
@@ -51,10 +61,21 @@ number DNA2Interaction::pair_interaction_nonbonded(BaseParticle *p, BaseParticle
 	// The methods with "" in front of them are inherited from DNAInteraction. The
 	// other two methods belong to DNA2Interaction
 	number energy = _nonbonded_excluded_volume(p, q, false, update_forces);
-	energy += _hydrogen_bonding(p, q, false, update_forces);
+	number hb_energy = _hydrogen_bonding(p, q, false, update_forces);
+	energy += hb_energy;
 	energy += _cross_stacking(p, q, false, update_forces);
 	energy += _coaxial_stacking(p, q, false, update_forces);
-	energy += _debye_huckel(p, q, false, update_forces);
+	number dh_energy = _debye_huckel(p, q, false, update_forces);
+	energy += dh_energy;
+
+	if(_compute_parameter_derivatives) {
+		if(hb_energy != (number) 0.f) {
+			*_hb_derivatives[q->type][p->type] += hb_energy / F1_EPS[HYDR_F1][q->type][p->type];
+		}
+		if(dh_energy != (number) 0.f) {
+			_update_salt_derivative(p, q);
+		}
+	}
 
 	return energy;
 }
@@ -80,10 +101,13 @@ void DNA2Interaction::get_settings(input_file &inp) {
 
 	number lambda = _debye_huckel_lambdafactor * sqrt(_T / 0.1f) / sqrt(_salt_concentration);
 	// RHIGH gives the distance at which the smoothing begins
-	if(getInputNumber(&inp, "debye_huckel_rhigh", &_debye_huckel_RHIGH, 0) != KEY_FOUND) {
+	_debye_huckel_rhigh_fixed = (getInputNumber(&inp, "debye_huckel_rhigh", &_debye_huckel_RHIGH, 0) == KEY_FOUND);
+	if(!_debye_huckel_rhigh_fixed) {
 		_debye_huckel_RHIGH = 3.0 * lambda;
 	}
 
+	getInputBool(&inp, "compute_parameter_derivatives", &_compute_parameter_derivatives, 0);
+
 	// notify the user that major-minor grooving is switched on
 	// check whether it's set in the input file to avoid duplicate messages
 	bool tmp;
@@ -95,7 +119,7 @@ void DNA2Interaction::get_settings(input_file &inp) {
 void DNA2Interaction::init() {
 	DNAInteraction::init();
 
-	// set the default values for the stacking and hbonding well depths for oxDNA2
+	// set the default values for the hbonding well depths for oxDNA2
 	// we overwrite the values set by DNAInteraction
 	// Only overwrite if we're using the average-sequence model; if sequence-dependent
 	// parameters are used, they are set in DNAInteraction::init() and we don't need
@@ -103,19 +127,38 @@ void DNA2Interaction::init() {
 	if(_average) {
 		for(int i = 0; i < 5; i++) {
 			for(int j = 0; j < 5; j++) {
-				// stacking
-				F1_EPS[STCK_F1][i][j] = STCK_BASE_EPS_OXDNA2 + STCK_FACT_EPS_OXDNA2 * _T;
-				F1_SHIFT[STCK_F1][i][j] = F1_EPS[STCK_F1][i][j] * SQR(1 - exp(-(STCK_RC - STCK_R0) * STCK_A));
-
-				// HB
 				F1_EPS[HYDR_F1][i][j] = HYDR_EPS_OXDNA2;
 				F1_SHIFT[HYDR_F1][i][j] = F1_EPS[HYDR_F1][i][j] * SQR(1 - exp(-(HYDR_RC - HYDR_R0) * HYDR_A));
 			}
 		}
 	}
 
+	OX_LOG(Logger::LOG_INFO,"The Debye length at this temperature and salt concentration is %f", -1.0 / _minus_kappa);
+
+	if(_compute_parameter_derivatives) {
+		_init_parameter_derivatives();
+	}
+}
+
+void DNA2Interaction::_update_T_dependent_parameters() {
+	DNAInteraction::_update_T_dependent_parameters();
+
+	// the oxDNA2 average-sequence stacking strengths differ from the oxDNA ones
+	if(_average) {
+		for(int i = 0; i < 5; i++) {
+			for(int j = 0; j < 5; j++) {
+				F1_EPS[STCK_F1][i][j] = STCK_BASE_EPS_OXDNA2 + STCK_FACT_EPS_OXDNA2 * _T;
+				F1_SHIFT[STCK_F1][i][j] = F1_EPS[STCK_F1][i][j] * SQR(1 - exp(-(STCK_RC - STCK_R0) * STCK_A));
+			}
+		}
+	}
+
 	// We wish to normalise with respect to T=300K, I=1M. 300K=0.1 s.u. so divide _T by 0.1
 	number lambda = _debye_huckel_lambdafactor * sqrt(_T / 0.1f) / sqrt(_salt_concentration);
+	// unless it has been set by the user, rhigh follows the Debye length
+	if(!_debye_huckel_rhigh_fixed) {
+		_debye_huckel_RHIGH = 3.0 * lambda;
+	}
 	_minus_kappa = -1.0 / lambda;
 
 	// these are just for convenience for the smoothing parameter computation
@@ -143,7 +186,42 @@ void DNA2Interaction::init() {
 	// NB lambda goes into the exponent for the D-H potential and is given by lambda = lambda_k * sqrt((T/300K)/(I/1M))
 	OX_LOG(Logger::LOG_DEBUG,"Debye-Huckel parameters: Q=%f, lambda_0=%f, lambda=%f, r_high=%f, cutoff=%f", _debye_huckel_prefactor, _debye_huckel_lambdafactor, lambda, _debye_huckel_RHIGH, _rcut);
 	OX_LOG(Logger::LOG_DEBUG,"Debye-Huckel parameters: debye_huckel_RC=%e, debye_huckel_B=%e", _debye_huckel_RC, _debye_huckel_B);
-	OX_LOG(Logger::LOG_INFO,"The Debye length at this temperature and salt concentration is %f", lambda);
+}
+
+void DNA2Interaction::_init_parameter_derivatives() {
+	// init() may be called more than once, so we start from scratch
+	_parameter_derivatives.clear();
+
+	// with the average-sequence model all the nucleotide types share the same well depths
+	for(int i = 0; i < 5; i++) {
+		for(int j = 0; j < 5; j++) {
+			std::string stck_key = (_average) ? "STCK_EPS" : Utils::sformat("STCK_%c_%c", Utils::encode_base(i), Utils::encode_base(j));
+			_stacking_derivatives[i][j] = &_parameter_derivatives[stck_key];
+
+			// the HB well depth is symmetric, so we use a single key for each pair of types
+			std::string hydr_key = (_average) ? "HYDR_EPS" : Utils::sformat("HYDR_%c_%c", Utils::encode_base(std::min(i, j)), Utils::encode_base(std::max(i, j)));
+			_hb_derivatives[i][j] = &_parameter_derivatives[hydr_key];
+		}
+	}
+
+	_salt_derivative = &_parameter_derivatives["salt_concentration"];
+}
+
+void DNA2Interaction::_update_salt_derivative(BaseParticle *p, BaseParticle *q) {
+	number cut_factor = 1.0f;
+	if(_debye_huckel_half_charged_ends && (p->n3 == P_VIRTUAL || p->n5 == P_VIRTUAL))
+		cut_factor *= 0.5f;
+	if(_debye_huckel_half_charged_ends && (q->n3 == P_VIRTUAL || q->n5 == P_VIRTUAL))
+		cut_factor *= 0.5f;
+
+	LR_vector rback = _computed_r + q->int_centers[DNANucleotide::BACK] - p->int_centers[DNANucleotide::BACK];
+	number lambda = -1.0 / _minus_kappa;
+	// rhigh is proportional to lambda, unless it has been set by the user
+	number drhigh_dlambda = (_debye_huckel_rhigh_fixed) ? 0. : _debye_huckel_RHIGH / lambda;
+	number dE_dlambda = cut_factor * InteractionUtils::debye_huckel_dlambda(rback.module(), _debye_huckel_prefactor, lambda, _debye_huckel_RHIGH, drhigh_dlambda);
+
+	// lambda is proportional to the inverse square root of the salt concentration
+	*_salt_derivative += dE_dlambda * (-0.5 * lambda / _salt_concentration);
 }
 
 number DNA2Interaction::_debye_huckel(BaseParticle *p, BaseParticle *q, bool compute_r, bool update_forces) {
@@ -17,6 +17,7 @@
  [dh_lambda = <float> (the value that lambda, which is a function of temperature (T) and salt concentration (I), should take when T=300K and I=1M, defaults to the value from Debye-Huckel theory, 0.3616455)]
  [dh_strength = <float> (the value that scales the overall strength of the Debye-Huckel interaction, defaults to 0.0543)]
  [dh_half_charged_ends = <bool>  (set to false for 2N charges for an N-base-pair duplex, defaults to 1)]
+ [compute_parameter_derivatives = <bool> (if true, the derivatives of the energy with respect to the stacking and hydrogen-bonding well depths and to the salt concentration are accumulated whenever the energy or the forces are computed. Defaults to false)]
  @endverbatim
  */
 
@@ -38,6 +39,19 @@ protected:
 	number _debye_huckel_RHIGH; // distance after which the potential is replaced by a quadratic cut-off
 	number _debye_huckel_B; // prefactor of the quadratic cut-off
 	number _minus_kappa;
+	/// true if debye_huckel_rhigh has been set in the input file and hence does not change with the Debye length
+	bool _debye_huckel_rhigh_fixed;
+
+	bool _compute_parameter_derivatives;
+	/// pointers to the elements of _parameter_derivatives associated to each pair of nucleotide types
+	number *_stacking_derivatives[5][5];
+	number *_hb_derivatives[5][5];
+	number *_salt_derivative;
+
+	void _init_parameter_derivatives();
+	void _update_salt_derivative(BaseParticle *p, BaseParticle *q);
+
+	virtual void _update_T_dependent_parameters();
 
 	number _f4_pure_harmonic(number t, int type);
 	number _f4Dsin_pure_harmonic(number t, int type);
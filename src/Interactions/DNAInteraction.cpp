@@ -221,11 +221,14 @@ DNAInteraction::DNAInteraction() :
 	_mbf_fmax = 0.f;
 	_mbf_finf = 0.f; // roughly 2pN
 
-	CONFIG_INFO->subscribe("T_updated", [this]() { this->_on_T_update(); });
+	CONFIG_INFO->subscribe(ConfigInfo::T_UPDATED, [this]() { this->_on_T_update(); }, this);
 }
 
 DNAInteraction::~DNAInteraction() {
-
+	// the callback subscribed in the constructor captures this
+	if(ConfigInfo::initialised()) {
+		CONFIG_INFO->unsubscribe(this);
+	}
 }
 
 void DNAInteraction::get_settings(input_file &inp) {
@@ -293,27 +296,9 @@ void DNAInteraction::get_settings(input_file &inp) {
 }
 
 void DNAInteraction::init() {
-	// we choose rcut as the max of the range interaction of excluded
-	// volume between backbones and hydrogen bonding
-	number rcutback;
-	if(_grooving) {
-		rcutback = 2 * sqrt((POS_MM_BACK1) * (POS_MM_BACK1) + (POS_MM_BACK2) * (POS_MM_BACK2)) + EXCL_RC1;
-	}
-	else {
-		rcutback = 2 * fabs(POS_BACK) + EXCL_RC1;
-	}
-	number rcutbase = 2 * fabs(POS_BASE) + HYDR_RCHIGH;
-	_rcut = fmax(rcutback, rcutbase);
-	_sqr_rcut = SQR(_rcut);
-
 	// set the default values
 	for(int i = 0; i < 5; i++) {
 		for(int j = 0; j < 5; j++) {
-			// stacking
-			F1_EPS[STCK_F1][i][j] = STCK_BASE_EPS_OXDNA + STCK_FACT_EPS_OXDNA * _T;
-			F1_SHIFT[STCK_F1][i][j] = F1_EPS[STCK_F1][i][j] * SQR(1 - exp(-(STCK_RC - STCK_R0) * STCK_A));
-
-			// HB
 			F1_EPS[HYDR_F1][i][j] = HYDR_EPS_OXDNA;
 			F1_SHIFT[HYDR_F1][i][j] = F1_EPS[HYDR_F1][i][j] * SQR(1 - exp(-(HYDR_RC - HYDR_R0) * HYDR_A));
 		}
@@ -325,21 +310,20 @@ void DNAInteraction::init() {
 	// keeps the default value)
 	if(!_average) {
 		char key[256];
-		float tmp_value, stck_fact_eps;
+		float tmp_value;
 
 		input_file seq_file;
 		seq_file.init_from_filename(_seq_filename.c_str());
 		if(seq_file.state == ERROR)
 			throw oxDNAException("Caught an error while opening sequence dependence file '%s'", _seq_filename.c_str());
 
-		// stacking
-		getInputFloat(&seq_file, "STCK_FACT_EPS", &stck_fact_eps, 1);
+		// stacking: the actual strengths depend on T and are set by _update_T_dependent_parameters()
+		getInputFloat(&seq_file, "STCK_FACT_EPS", &_seq_stck_fact_eps, 1);
 		for(int i = 0; i < 4; i++) {
 			for(int j = 0; j < 4; j++) {
 				sprintf(key, "STCK_%c_%c", Utils::encode_base(i), Utils::encode_base(j));
 				getInputFloat(&seq_file, key, &tmp_value, 1);
-				F1_EPS[STCK_F1][i][j] = tmp_value * (1.0 - stck_fact_eps + (_T * 9.0 * stck_fact_eps));
-				F1_SHIFT[STCK_F1][i][j] = F1_EPS[STCK_F1][i][j] * SQR(1 - exp(-(STCK_RC - STCK_R0) * STCK_A));
+				_seq_stck_eps[i][j] = tmp_value;
 			}
 		}
 
@@ -349,8 +333,7 @@ void DNAInteraction::init() {
 				if(i == 4 || j == 4) {
 					sprintf(key, "STCK_%c_%c", Utils::encode_base(i), Utils::encode_base(j));
 					getInputFloat(&seq_file, key, &tmp_value, 0);
-					F1_EPS[STCK_F1][i][j] = tmp_value * (1.0 - stck_fact_eps + (_T * 9.0 * stck_fact_eps));
-					F1_SHIFT[STCK_F1][i][j] = F1_EPS[STCK_F1][i][j] * SQR(1 - exp(-(STCK_RC - STCK_R0) * STCK_A));
+					_seq_stck_eps[i][j] = tmp_value;
 				}
 			}
 		}
@@ -370,14 +353,43 @@ void DNAInteraction::init() {
 		F1_EPS[HYDR_F1][N_G][N_C] = F1_EPS[HYDR_F1][N_C][N_G] = tmp_value;
 		F1_SHIFT[HYDR_F1][N_G][N_C] = F1_SHIFT[HYDR_F1][N_C][N_G] = F1_EPS[HYDR_F1][N_G][N_C] * SQR(1 - exp(-(HYDR_RC - HYDR_R0) * HYDR_A));
 	}
+
+	_update_T_dependent_parameters();
+}
+
+void DNAInteraction::_update_T_dependent_parameters() {
+	// we choose rcut as the max of the range interaction of excluded
+	// volume between backbones and hydrogen bonding
+	number rcutback;
+	if(_grooving) {
+		rcutback = 2 * sqrt((POS_MM_BACK1) * (POS_MM_BACK1) + (POS_MM_BACK2) * (POS_MM_BACK2)) + EXCL_RC1;
+	}
+	else {
+		rcutback = 2 * fabs(POS_BACK) + EXCL_RC1;
+	}
+	number rcutbase = 2 * fabs(POS_BASE) + HYDR_RCHIGH;
+	_rcut = fmax(rcutback, rcutbase);
+	_sqr_rcut = SQR(_rcut);
+
+	for(int i = 0; i < 5; i++) {
+		for(int j = 0; j < 5; j++) {
+			if(_average) {
+				F1_EPS[STCK_F1][i][j] = STCK_BASE_EPS_OXDNA + STCK_FACT_EPS_OXDNA * _T;
+			}
+			else {
+				F1_EPS[STCK_F1][i][j] = _seq_stck_eps[i][j] * (1.0 - _seq_stck_fact_eps + (_T * 9.0 * _seq_stck_fact_eps));
+			}
+			F1_SHIFT[STCK_F1][i][j] = F1_EPS[STCK_F1][i][j] * SQR(1 - exp(-(STCK_RC - STCK_R0) * STCK_A));
+		}
+	}
 }
 
 void DNAInteraction::_on_T_update() {
 	_T = CONFIG_INFO->temperature();
 	number T_in_C = _T * 3000 - 273.15;
 	number T_in_K = _T * 3000;
-	OX_LOG(Logger::LOG_INFO, "Temperature change detected (new temperature: %.2lf C, %.2lf K), re-initialising the DNA interaction", T_in_C, T_in_K);
-	init();
+	OX_LOG(Logger::LOG_INFO, "Temperature change detected (new temperature: %.2lf C, %.2lf K), updating the temperature-dependent parameters of the DNA interaction", T_in_C, T_in_K);
+	_update_T_dependent_parameters();
 }
 
 bool DNAInteraction::_check_bonded_neighbour(BaseParticle **p, BaseParticle **q, bool compute_r) {
@@ -1450,6 +1462,14 @@ void DNAInteraction::check_input_sanity(std::vector<BaseParticle*> &particles) {
 	}
 }
 
+llint DNAInteraction::memory_footprint() {
+	llint footprint = 0;
+	for(auto &mesh : _mesh_f4) {
+		footprint += mesh.memory_footprint();
+	}
+	return footprint;
+}
+
 void DNAInteraction::allocate_particles(std::vector<BaseParticle*> &particles) {
 	for(uint i = 0; i < particles.size(); i++) {
 		particles[i] = new DNANucleotide(_grooving);
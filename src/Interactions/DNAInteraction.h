@@ -34,8 +34,20 @@ protected:
 	int MESH_F4_POINTS[13];
 	Mesh _mesh_f4[13];
 
+	/// the raw stacking strengths read from the sequence-dependence file, stored so that they can be rescaled when T changes
+	float _seq_stck_eps[5][5] = {};
+	float _seq_stck_fact_eps = 0.f;
+
 	virtual void _on_T_update();
 
+	/**
+	 * @brief Updates the cutoff and the coefficients that depend on the temperature (e.g. the stacking strengths).
+	 *
+	 * It is called by init() and whenever the temperature changes. Contrary to init(), it does not rebuild the
+	 * meshes nor re-read the sequence-dependence file.
+	 */
+	virtual void _update_T_dependent_parameters();
+
 	number _f1(number r, int type, int n3, int n5);
 	number _f1D(number r, int type, int n3, int n5);
 	number _f2(number r, int type);
@@ -107,6 +119,8 @@ public:
 	virtual void get_settings(input_file &inp);
 	virtual void init();
 
+	virtual llint memory_footprint();
+
 	virtual void allocate_particles(std::vector<BaseParticle *> &particles);
 
 	bool has_custom_stress_tensor() const override {
@@ -953,6 +953,9 @@ number DRHInteraction::pair_interaction_bonded(BaseParticle *p, BaseParticle *q,
 	
 }
 
+llint DRHInteraction::memory_footprint() {
+	return DNA2Interaction::memory_footprint() + RNA2Interaction::memory_footprint();
+}
 
 void DRHInteraction::allocate_particles(std::vector<BaseParticle*> &particles) {
 
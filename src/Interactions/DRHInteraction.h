@@ -123,6 +123,7 @@ public:
 
 	virtual void get_settings(input_file &inp);
 	virtual void init();  //apparently renaming many or all of the below methods causes errors
+	virtual llint memory_footprint();
 	virtual void allocate_particles(std::vector<BaseParticle *> &particles);  
 
 	virtual number pair_interaction(BaseParticle *p, BaseParticle *q, bool compute_r = true, bool update_forces=false);
@@ -920,3 +920,23 @@ bool triangle_intersection(LR_vector * P1, LR_vector * P2, LR_vector * P3, LR_ve
 	return false;
 }
 
+number InteractionUtils::debye_huckel_dlambda(number r, number prefactor, number lambda, number rhigh, number drhigh_dlambda) {
+	number x = rhigh;
+	number l = lambda;
+	number rc = x * (x + 3. * l) / (x + l);
+
+	if(r >= rc) {
+		return (number) 0.f;
+	}
+
+	// the two branches are continuous in r = rhigh, so that moving rhigh does not contribute to the derivative
+	if(r < x) {
+		return prefactor * exp(-r / l) / SQR(l);
+	}
+
+	number B = prefactor * exp(-x / l) * SQR(x + l) / (4. * x * x * x * l * l);
+	number dlogB = x / SQR(l) + 2. / (x + l) - 2. / l + drhigh_dlambda * (-1. / l + 2. / (x + l) - 3. / x);
+	number drc = (2. * x * x + drhigh_dlambda * (x * x + 2. * x * l + 3. * l * l)) / SQR(x + l);
+
+	return B * SQR(r - rc) * dlogB - 2. * B * (r - rc) * drc;
+}
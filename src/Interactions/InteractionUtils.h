@@ -161,6 +161,20 @@ public:
 	 * @param P3 pointer to vector defining the third vertex of the triangle
 	 */
 	static bool edge_triangle_intersection(LR_vector &S1, LR_vector &S2, LR_vector &P1, LR_vector &P2, LR_vector &P3);
+
+	/**
+	 * @brief derivative of the smoothed Debye-Huckel potential used by oxDNA2 and oxRNA2 with respect to the Debye length
+	 *
+	 * The potential is a screened Coulomb term up to rhigh, which is then smoothly brought to zero by a quadratic
+	 * function whose coefficients depend on the Debye length.
+	 *
+	 * @param r distance between the two charges
+	 * @param prefactor strength of the interaction
+	 * @param lambda Debye length
+	 * @param rhigh distance at which the quadratic smoothing begins
+	 * @param drhigh_dlambda derivative of rhigh with respect to the Debye length (0 if rhigh is kept fixed)
+	 */
+	static number debye_huckel_dlambda(number r, number prefactor, number lambda, number rhigh, number drhigh_dlambda);
 };
 
 #endif /* INTERACTION_UTILS_H_ */
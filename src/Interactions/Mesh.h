@@ -70,6 +70,13 @@ public:
 		return _xlow;
 	}
 
+	/**
+	 * @brief Returns the memory used by the mesh tables, in bytes.
+	 */
+	llint memory_footprint() const {
+		return (llint) (_A.capacity() + _B.capacity() + _C.capacity() + _D.capacity()) * sizeof(number);
+	}
+
 private:
 	int _N;
 	number _delta, _inv_sqr_delta, _xlow, _xupp;
@@ -34,13 +34,25 @@ RNAInteraction::RNAInteraction() :
 	_mbf_fmax = 0.f;
 	_mbf_finf = 0.f;
 
-	CONFIG_INFO->subscribe("T_updated", [this]() { this->_on_T_update(); });
+	CONFIG_INFO->subscribe(ConfigInfo::T_UPDATED, [this]() { this->_on_T_update(); }, this);
 }
 
 RNAInteraction::~RNAInteraction() {
+	// the callback subscribed in the constructor captures this
+	if(ConfigInfo::initialised()) {
+		CONFIG_INFO->unsubscribe(this);
+	}
 	delete model;
 }
 
+llint RNAInteraction::memory_footprint() {
+	llint footprint = 0;
+	for(auto &mesh : _mesh_f4) {
+		footprint += mesh.memory_footprint();
+	}
+	return footprint;
+}
+
 void RNAInteraction::allocate_particles(std::vector<BaseParticle*> &particles) {
 	RNANucleotide::set_model(model);
 	for(uint i = 0; i < particles.size(); i++)
@@ -105,15 +117,6 @@ void RNAInteraction::get_settings(input_file &inp) {
 }
 
 void RNAInteraction::init() {
-	// we choose rcut as the max of the range interaction of excluded
-	// volume between backbones and hydrogen bonding
-	number rcutback = 2 * sqrt(SQR(model->RNA_POS_BACK_a1) + SQR(model->RNA_POS_BACK_a2) + SQR(model->RNA_POS_BACK_a3)) + model->RNA_EXCL_RC1;
-	number rcutbaseA = 2 * fabs(model->RNA_POS_BASE) + model->RNA_HYDR_RCHIGH;
-	number rcutbaseB = 2 * fabs(model->RNA_POS_BASE) + model->RNA_CRST_RCHIGH;
-	number rcutbase = fmax(rcutbaseA, rcutbaseB);
-	_rcut = fmax(rcutback, rcutbase);
-	_sqr_rcut = SQR(_rcut);
-
 	F1_A[0] = model->RNA_HYDR_A;
 	F1_A[1] = model->RNA_STCK_A;
 
@@ -324,11 +327,6 @@ void RNAInteraction::init() {
 	// set the default values
 	for(int i = 0; i < 5; i++) {
 		for(int j = 0; j < 5; j++) {
-			// stacking
-			F1_EPS[RNA_STCK_F1][i][j] = model->RNA_STCK_BASE_EPS + model->RNA_STCK_FACT_EPS * _T;
-			F1_SHIFT[RNA_STCK_F1][i][j] = F1_EPS[RNA_STCK_F1][i][j] * SQR(1 - exp(-(model->RNA_STCK_RC - model->RNA_STCK_R0) * model->RNA_STCK_A));
-
-			// HB
 			F1_EPS[RNA_HYDR_F1][i][j] = model->RNA_HYDR_EPS;
 			F1_SHIFT[RNA_HYDR_F1][i][j] = F1_EPS[RNA_HYDR_F1][i][j] * SQR(1 - exp(-(model->RNA_HYDR_RC - model->RNA_HYDR_R0) * model->RNA_HYDR_A));
 		}
@@ -340,21 +338,20 @@ void RNAInteraction::init() {
 	// keeps the default value)
 	if(!_average) {
 		char key[256];
-		float tmp_value, stck_fact_eps;
+		float tmp_value;
 
 		input_file seq_file;
 		seq_file.init_from_filename(_seq_filename);
 		if(seq_file.state == ERROR)
 			throw oxDNAException("Caught an error while opening sequence dependence file '%s'", _seq_filename);
 
-		// stacking
-		getInputFloat(&seq_file, "ST_T_DEP", &stck_fact_eps, 1);
+		// stacking: the actual strengths depend on T and are set by _update_T_dependent_parameters()
+		getInputFloat(&seq_file, "ST_T_DEP", &_seq_stck_fact_eps, 1);
 		for(int i = 0; i < 4; i++) {
 			for(int j = 0; j < 4; j++) {
 				sprintf(key, "STCK_%c_%c", Utils::encode_base(i), Utils::encode_base(j));
 				getInputFloat(&seq_file, key, &tmp_value, 1);
-				F1_EPS[RNA_STCK_F1][i][j] = tmp_value * (1.0 + _T * stck_fact_eps); //F1_EPS[RNA_STCK_F1][i][j] = tmp_value + stck_fact_eps * T;
-				F1_SHIFT[RNA_STCK_F1][i][j] = F1_EPS[RNA_STCK_F1][i][j] * SQR(1 - exp(-(model->RNA_STCK_RC - model->RNA_STCK_R0) * model->RNA_STCK_A));
+				_seq_stck_eps[i][j] = tmp_value;
 			}
 		}
 		// cross-stacking
@@ -388,17 +385,43 @@ void RNAInteraction::init() {
 		F1_SHIFT[RNA_HYDR_F1][N_G][N_T] = F1_SHIFT[RNA_HYDR_F1][N_T][N_G] = F1_EPS[RNA_HYDR_F1][N_G][N_T] * SQR(1 - exp(-(model->RNA_HYDR_RC - model->RNA_HYDR_R0) * model->RNA_HYDR_A));
 	}
 
+	_update_T_dependent_parameters();
+
 	if(_use_mbf) {
 		OX_LOG(Logger::LOG_INFO, "Using a maximum backbone force of %g  (the corresponding mbf_xmax is %g) and a far value of %g", _mbf_fmax, _mbf_xmax, _mbf_finf);
 	}
 }
 
+void RNAInteraction::_update_T_dependent_parameters() {
+	// we choose rcut as the max of the range interaction of excluded
+	// volume between backbones and hydrogen bonding
+	number rcutback = 2 * sqrt(SQR(model->RNA_POS_BACK_a1) + SQR(model->RNA_POS_BACK_a2) + SQR(model->RNA_POS_BACK_a3)) + model->RNA_EXCL_RC1;
+	number rcutbaseA = 2 * fabs(model->RNA_POS_BASE) + model->RNA_HYDR_RCHIGH;
+	number rcutbaseB = 2 * fabs(model->RNA_POS_BASE) + model->RNA_CRST_RCHIGH;
+	number rcutbase = fmax(rcutbaseA, rcutbaseB);
+	_rcut = fmax(rcutback, rcutbase);
+	_sqr_rcut = SQR(_rcut);
+
+	for(int i = 0; i < 5; i++) {
+		for(int j = 0; j < 5; j++) {
+			// the stacking between dummy bases or regular bases and dummy bases always keeps the default value
+			if(!_average && i < 4 && j < 4) {
+				F1_EPS[RNA_STCK_F1][i][j] = _seq_stck_eps[i][j] * (1.0 + _T * _seq_stck_fact_eps);
+			}
+			else {
+				F1_EPS[RNA_STCK_F1][i][j] = model->RNA_STCK_BASE_EPS + model->RNA_STCK_FACT_EPS * _T;
+			}
+			F1_SHIFT[RNA_STCK_F1][i][j] = F1_EPS[RNA_STCK_F1][i][j] * SQR(1 - exp(-(model->RNA_STCK_RC - model->RNA_STCK_R0) * model->RNA_STCK_A));
+		}
+	}
+}
+
 void RNAInteraction::_on_T_update() {
 	_T = CONFIG_INFO->temperature();
 	number T_in_C = _T * 3000 - 273.15;
 	number T_in_K = _T * 3000;
-	OX_LOG(Logger::LOG_INFO, "Temperature change detected (new temperature: %.2lf C, %.2lf K), re-initialising the RNA interaction", T_in_C, T_in_K);
-	init();
+	OX_LOG(Logger::LOG_INFO, "Temperature change detected (new temperature: %.2lf C, %.2lf K), updating the temperature-dependent parameters of the RNA interaction", T_in_C, T_in_K);
+	_update_T_dependent_parameters();
 }
 
 bool RNAInteraction::_check_bonded_neighbour(BaseParticle **p, BaseParticle **q, bool compute_r) {
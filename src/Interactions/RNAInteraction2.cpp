@@ -1,5 +1,6 @@
 #include "RNAInteraction2.h"
 
+#include "InteractionUtils.h"
 #include "../Particles/RNANucleotide.h"
 
 RNA2Interaction::RNA2Interaction() :
@@ -7,10 +8,38 @@ RNA2Interaction::RNA2Interaction() :
 	ADD_INTERACTION_TO_MAP(DEBYE_HUCKEL, _debye_huckel);
 
 	_RNA_HYDR_MIS = 1;
+	_debye_huckel_rhigh_fixed = false;
+	_compute_parameter_derivatives = false;
+	_salt_derivative = nullptr;
 	// log the interaction type
 	OX_LOG(Logger::LOG_INFO,"Running modification of oxRNA with additional Debye-Huckel potential");
 }
 
+number RNA2Interaction::pair_interaction_bonded(BaseParticle *p, BaseParticle *q, bool compute_r, bool update_forces) {
+	if(!_compute_parameter_derivatives) {
+		return RNAInteraction::pair_interaction_bonded(p, q, compute_r, update_forces);
+	}
+
+	if(!_check_bonded_neighbour(&p, &q, compute_r)) {
+		return (number) 0.f;
+	}
+	if(compute_r) {
+		_computed_r = q->pos - p->pos;
+	}
+
+	number energy = _backbone(p, q, false, update_forces);
+	energy += _bonded_excluded_volume(p, q, false, update_forces);
+	number stacking_energy = _stacking(p, q, false, update_forces);
+	energy += stacking_energy;
+
+	// the stacking energy is proportional to the well depth
+	if(stacking_energy != (number) 0.f) {
+		*_stacking_derivatives[q->type][p->type] += stacking_energy / F1_EPS[RNA_STCK_F1][q->type][p->type];
+	}
+
+	return energy;
+}
+
 number RNA2Interaction::pair_interaction_nonbonded(BaseParticle *p, BaseParticle *q, bool compute_r, bool update_forces) {
 	if(compute_r) {
 		_computed_r = _box->min_image(p->pos, q->pos);
@@ -20,11 +49,33 @@ number RNA2Interaction::pair_interaction_nonbonded(BaseParticle *p, BaseParticle
 	if(_computed_r.norm() >= _sqr_rcut) {
 		return (number) 0.f;
 	}
-	// compute the interaction energy as always ...
-	number energy = RNAInteraction::pair_interaction_nonbonded(p, q, false, update_forces);
 
-	// ... and then add the debye_huckel energy
-	energy += _debye_huckel(p, q, false, update_forces);
+	if(!_compute_parameter_derivatives) {
+		// compute the interaction energy as always ...
+		number energy = RNAInteraction::pair_interaction_nonbonded(p, q, false, update_forces);
+
+		// ... and then add the debye_huckel energy
+		energy += _debye_huckel(p, q, false, update_forces);
+
+		return energy;
+	}
+
+	// same as above, but here we need to keep track of the single contributions
+	number energy = _nonbonded_excluded_volume(p, q, false, update_forces);
+	number hb_energy = _hydrogen_bonding(p, q, false, update_forces);
+	energy += hb_energy;
+	energy += _cross_stacking(p, q, false, update_forces);
+	energy += _coaxial_stacking(p, q, false, update_forces);
+	number dh_energy = _debye_huckel(p, q, false, update_forces);
+	energy += dh_energy;
+
+	// the mismatch repulsion does not depend on the HB well depth
+	if(hb_energy != (number) 0.f && _is_hb_pair(p, q)) {
+		*_hb_derivatives[q->type][p->type] += hb_energy / F1_EPS[RNA_HYDR_F1][q->type][p->type];
+	}
+	if(dh_energy != (number) 0.f) {
+		_update_salt_derivative(p, q);
+	}
 
 	return energy;
 }
@@ -48,9 +99,12 @@ void RNA2Interaction::get_settings(input_file &inp) {
 	}
 
 	number lambda = _debye_huckel_lambdafactor * sqrt(_T / 0.1f) / sqrt(_salt_concentration);
-	if(getInputNumber(&inp, "debye_huckel_rhigh", &_debye_huckel_RHIGH, 0) != KEY_FOUND) {
+	_debye_huckel_rhigh_fixed = (getInputNumber(&inp, "debye_huckel_rhigh", &_debye_huckel_RHIGH, 0) == KEY_FOUND);
+	if(!_debye_huckel_rhigh_fixed) {
 		_debye_huckel_RHIGH = 3.0 * lambda;
 	}
+
+	getInputBool(&inp, "compute_parameter_derivatives", &_compute_parameter_derivatives, 0);
 	// read the mismatch_repulsion flag (not implemented yet)
 	if(getInputBool(&inp, "mismatch_repulsion", &_mismatch_repulsion, 0) != KEY_FOUND) {
 		_mismatch_repulsion = false;
@@ -80,8 +134,32 @@ void RNA2Interaction::init() {
 	//perform the initialisation as in RNAinteraction
 	RNAInteraction::init();
 
+	// log the parameters of the Debye-Huckel
+	OX_LOG(Logger::LOG_INFO,"DEBUGGING: rhigh is %g, Cutoff is %g, RC huckel is %g, B huckel is %g, V is %g, lambda is %g ",_debye_huckel_RHIGH,_rcut,_debye_huckel_RC, _debye_huckel_B,_debye_huckel_Vrc,-1.0 / _minus_kappa);
+	OX_LOG(Logger::LOG_INFO,"DEBUGGING: dh_half_charged_ends = %s", _debye_huckel_half_charged_ends ? "true" : "false");
+
+	if(_mismatch_repulsion) {
+		float temp = -1.0f * _RNA_HYDR_MIS / model->RNA_HYDR_EPS;
+		F1_EPS[RNA_HYDR_F1][0][0] *= temp;
+		F1_SHIFT[RNA_HYDR_F1][0][0] *= temp;
+		OX_LOG(Logger::LOG_INFO,"Using mismatch repulsion with strength %f",_RNA_HYDR_MIS);
+
+	}
+
+	if(_compute_parameter_derivatives) {
+		_init_parameter_derivatives();
+	}
+}
+
+void RNA2Interaction::_update_T_dependent_parameters() {
+	RNAInteraction::_update_T_dependent_parameters();
+
 	//compute the DH length lambda
 	number lambda = _debye_huckel_lambdafactor * sqrt(_T / 0.1f) / sqrt(_salt_concentration);
+	// unless it has been set by the user, rhigh follows the Debye length
+	if(!_debye_huckel_rhigh_fixed) {
+		_debye_huckel_RHIGH = 3.0 * lambda;
+	}
 
 	_debye_huckel_Vrc = 0;
 	_minus_kappa = -1.0 / lambda;
@@ -100,19 +178,49 @@ void RNA2Interaction::init() {
 		_rcut = debyecut;
 		_sqr_rcut = debyecut * debyecut;
 	}
-	// log the parameters of the Debye-Huckel
+}
 
-	OX_LOG(Logger::LOG_INFO,"DEBUGGING: rhigh is %g, Cutoff is %g, RC huckel is %g, B huckel is %g, V is %g, lambda is %g ",_debye_huckel_RHIGH,_rcut,_debye_huckel_RC, _debye_huckel_B,_debye_huckel_Vrc,lambda);
-	OX_LOG(Logger::LOG_INFO,"DEBUGGING: dh_half_charged_ends = %s", _debye_huckel_half_charged_ends ? "true" : "false");
+void RNA2Interaction::_init_parameter_derivatives() {
+	// init() may be called more than once, so we start from scratch
+	_parameter_derivatives.clear();
 
-	if(_mismatch_repulsion) {
-		float temp = -1.0f * _RNA_HYDR_MIS / model->RNA_HYDR_EPS;
-		F1_EPS[RNA_HYDR_F1][0][0] *= temp;
-		F1_SHIFT[RNA_HYDR_F1][0][0] *= temp;
-		OX_LOG(Logger::LOG_INFO,"Using mismatch repulsion with strength %f",_RNA_HYDR_MIS);
+	for(int i = 0; i < 5; i++) {
+		for(int j = 0; j < 5; j++) {
+			std::string stck_key = (_average) ? "STCK_EPS" : Utils::sformat("STCK_%c_%c", Utils::encode_base(i), Utils::encode_base(j));
+			_stacking_derivatives[i][j] = &_parameter_derivatives[stck_key];
 
+			std::string hydr_key = (_average) ? "HYDR_EPS" : Utils::sformat("HYDR_%c_%c", Utils::encode_base(std::min(i, j)), Utils::encode_base(std::max(i, j)));
+			_hb_derivatives[i][j] = &_parameter_derivatives[hydr_key];
+		}
 	}
 
+	_salt_derivative = &_parameter_derivatives["salt_concentration"];
+}
+
+void RNA2Interaction::_update_salt_derivative(BaseParticle *p, BaseParticle *q) {
+	number cut_factor = 1.0f;
+	if(_debye_huckel_half_charged_ends && (p->n3 == P_VIRTUAL || p->n5 == P_VIRTUAL))
+		cut_factor *= 0.5f;
+	if(_debye_huckel_half_charged_ends && (q->n3 == P_VIRTUAL || q->n5 == P_VIRTUAL))
+		cut_factor *= 0.5f;
+
+	LR_vector rback = _computed_r + q->int_centers[RNANucleotide::BACK] - p->int_centers[RNANucleotide::BACK];
+	number lambda = -1.0 / _minus_kappa;
+	number drhigh_dlambda = (_debye_huckel_rhigh_fixed) ? 0. : _debye_huckel_RHIGH / lambda;
+	number dE_dlambda = cut_factor * InteractionUtils::debye_huckel_dlambda(rback.module(), _debye_huckel_prefactor, lambda, _debye_huckel_RHIGH, drhigh_dlambda);
+
+	*_salt_derivative += dE_dlambda * (-0.5 * lambda / _salt_concentration);
+}
+
+bool RNA2Interaction::_is_hb_pair(BaseParticle *p, BaseParticle *q) {
+	// true if p and q are Watson-Crick-like pairs
+	bool is_pair = (q->btype + p->btype == 3);
+	if(!_average) { //allow for wobble bp
+		if(q->btype + p->btype == 4 && ((q->type == N_T && p->type == N_G) || (q->type == N_G && p->type == N_T))) {
+			is_pair = true;
+		}
+	}
+	return is_pair;
 }
 
 //to be removed later, the following function is just for debugging
@@ -368,15 +476,7 @@ number RNA2Interaction::_hydrogen_bonding(BaseParticle *p, BaseParticle *q, bool
 	if(_are_bonded(p, q))
 		return (number) 0.f;
 
-	// true if p and q are Watson-Crick-like pairs
-	bool is_pair = (q->btype + p->btype == 3);
-	if(!_average) //allow for wobble bp
-	{
-		if(q->btype + p->btype == 4 && ((q->type == N_T && p->type == N_G) || (q->type == N_G && p->type == N_T)))
-			is_pair = true;
-	}
-
-	if(is_pair) {
+	if(_is_hb_pair(p, q)) {
 		return RNAInteraction::_hydrogen_bonding(p, q, compute_r, update_forces);
 	}
 	else if(_mismatch_repulsion) {
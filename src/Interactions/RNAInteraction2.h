@@ -1,6 +1,10 @@
 /**
  * @brief Handles interactions between RNA nucleotides. Contains additionally interactions (mismatch repulsion, salt) with respect to RNA Interaction class
  * Implements RNA2 model
+ *
+ * @verbatim
+[compute_parameter_derivatives = <bool> (if true, the derivatives of the energy with respect to the stacking and hydrogen-bonding well depths and to the salt concentration are accumulated whenever the energy or the forces are computed. Defaults to false)]
+@endverbatim
  */
 
 #ifndef RNA2_INTERACTION_H
@@ -27,6 +31,18 @@ protected:
 	number _debye_huckel_B; //prefactor of the quadratic cut-off
 	number _debye_huckel_RHIGH; //distance after which the potential is replaced by a quadratic cut-off
 	number _minus_kappa; //= -1/lambda
+	bool _debye_huckel_rhigh_fixed; // true if rhigh does not change with lambda
+
+	bool _compute_parameter_derivatives;
+	number *_stacking_derivatives[5][5];
+	number *_hb_derivatives[5][5];
+	number *_salt_derivative;
+
+	void _init_parameter_derivatives();
+	void _update_salt_derivative(BaseParticle *p, BaseParticle *q);
+	bool _is_hb_pair(BaseParticle *p, BaseParticle *q);
+
+	virtual void _update_T_dependent_parameters();
 
 	//this is for the mismatch repulsion potential
 	float _RNA_HYDR_MIS;
@@ -44,6 +60,7 @@ public:
 	virtual ~RNA2Interaction() {
 	} // Destructor
 
+	virtual number pair_interaction_bonded(BaseParticle *p, BaseParticle *q, bool compute_r = true, bool update_forces = false);
 	virtual number pair_interaction_nonbonded(BaseParticle *p, BaseParticle *q, bool compute_r = true, bool update_forces = false);
 	virtual number _hydrogen_bonding(BaseParticle *p, BaseParticle *q, bool compute_r, bool update_forces);
 
@@ -94,6 +94,13 @@ public:
 	 */
 	virtual std::vector<ParticlePair > get_potential_interactions();
 
+	/**
+	 * @brief Returns an estimate of the memory used by the list's data structures, in bytes.
+	 */
+	virtual llint memory_footprint() {
+		return 0;
+	}
+
 	/**
 	 * @brief Informs the list object that the box has been changed
 	 */
@@ -7,31 +7,54 @@
 
 #include "BinVerletList.h"
 
+#include <algorithm>
+
 using namespace std;
 
 BinVerletList::BinVerletList(std::vector<BaseParticle *> &ps, BaseBox *box) :
 				BaseList(ps, box),
 				_updated(false),
-				_is_AO(false) {
+				_is_AO(false),
+				_N_species(2),
+				_cells(ps, box) {
 
 }
 
 BinVerletList::~BinVerletList() {
-	for(typename vector<Cells *>::iterator it = _cells.begin(); it != _cells.end(); it++)
-		delete *it;
+
 }
 
 void BinVerletList::get_settings(input_file &inp) {
 	BaseList::get_settings(inp);
+	_cells.get_settings(inp);
 
 	getInputNumber(&inp, "verlet_skin", &_skin, 1);
 	_sqr_skin = SQR(_skin);
 
-	getInputNumber(&inp, "bin_verlet_rcut[0]", _rcut, 1);
-	getInputNumber(&inp, "bin_verlet_rcut[1]", _rcut + 1, 1);
-	getInputNumber(&inp, "bin_verlet_rcut[2]", _rcut + 2, 1);
+	getInputInt(&inp, "bin_verlet_n_species", &_N_species, 0);
+	if(_N_species < 1) {
+		throw oxDNAException("bin_verlet_n_species should be a positive number (found %d)", _N_species);
+	}
+
+	_rcut.resize(_N_species * _N_species);
+	int k = 0;
+	for(int i = 0; i < _N_species; i++) {
+		for(int j = i; j < _N_species; j++, k++) {
+			char key[256];
+			sprintf(key, "bin_verlet_rcut[%d]", k);
+			getInputNumber(&inp, key, &_rcut[i * _N_species + j], 1);
+			_rcut[j * _N_species + i] = _rcut[i * _N_species + j];
+		}
+	}
 
 	getInputBool(&inp, "AO_mixture", &_is_AO, 0);
+	if(_is_AO) {
+		if(_N_species < 2) {
+			throw oxDNAException("AO_mixture requires bin_verlet_n_species >= 2");
+		}
+		// depletants do not interact with each other
+		_rcut[1 * _N_species + 1] = 0.;
+	}
 
 	if(this->_is_MC) {
 		float delta_t = 0.f;
@@ -41,30 +64,35 @@ void BinVerletList::get_settings(input_file &inp) {
 }
 
 void BinVerletList::init(number rcut) {
-	int N_part[2] = { 0, 0 };
-	for(uint i = 0; i < _particles.size(); i++) {
-		BaseParticle *p = _particles[i];
-		if(p->type != 0 && p->type != 1) throw oxDNAException("bin_verlet expects particles to be either of species 0 or 1, found %d", p->type);
+	std::vector<int> N_part(_N_species, 0);
+	for(auto p : _particles) {
+		if(p->type < 0 || p->type >= _N_species) throw oxDNAException("bin_verlet expects particles to be of species between 0 and %d, found %d", _N_species - 1, p->type);
 		N_part[p->type]++;
 	}
 
-	if(N_part[0] == 0) OX_LOG(Logger::LOG_WARNING, "No particles of species 0 detected, why using bin_verlet then?");
-	if(N_part[1] == 0) OX_LOG(Logger::LOG_WARNING, "No particles of species 1 detected, why using bin_verlet then?");
+	for(int i = 0; i < _N_species; i++) {
+		if(N_part[i] == 0) OX_LOG(Logger::LOG_WARNING, "No particles of species %d detected, why using bin_verlet then?", i);
+	}
 
-	for(int i = 0; i < 3; i++) {
-		_rcut[i] += 2 * _skin;
-		_sqr_rcut[i] = SQR(_rcut[i]);
-		Cells *cn = new Cells(_particles, _box);
-		cn->init(_rcut[i]);
-		_cells.push_back(cn);
+	// the cutoffs given in the input are left untouched, so that init() can be safely called more than once
+	std::vector<number> list_rcut(_rcut);
+	number max_rcut = 0.;
+	for(auto &pair_rcut : list_rcut) {
+		if(pair_rcut > 0.) {
+			pair_rcut += 2 * _skin;
+			max_rcut = std::max(max_rcut, pair_rcut);
+		}
+	}
+	if(max_rcut == 0.) {
+		throw oxDNAException("bin_verlet requires at least one positive cutoff");
 	}
 
-	_cells[0]->set_allowed_type(0);
-	_cells[1]->set_unlike_type_only();
-	_cells[2]->set_allowed_type(1);
+	_cells.set_pair_cutoffs(_N_species, list_rcut);
+	_cells.init(max_rcut);
 
 	_lists.resize(_particles.size(), std::vector<BaseParticle *>());
 	_list_poss.resize(_particles.size(), LR_vector(0, 0, 0));
+	_list_inv_box = this->_box->inverse_box_matrix();
 	global_update(true);
 }
 
@@ -73,25 +101,15 @@ bool BinVerletList::is_updated() {
 }
 
 void BinVerletList::single_update(BaseParticle *p) {
-	_cells[2 * p->type]->single_update(p);
-	_cells[1]->single_update(p);
+	_cells.single_update(p);
 	if(_list_poss[p->index].sqr_distance(p->pos) > _sqr_skin) _updated = false;
 }
 
 void BinVerletList::global_update(bool force_update) {
-	if(!_cells[0]->is_updated() || !_cells[1]->is_updated() || !_cells[2]->is_updated() || force_update) {
-		for(int i = 0; i < 3; i++)
-			_cells[i]->global_update();
-	}
-
-	for(uint i = 0; i < _particles.size(); i++) {
-		BaseParticle *p = this->_particles[i];
-		if(p->type == 0 || !_is_AO) _lists[p->index] = _cells[2 * p->type]->get_neigh_list(p);
-		else _lists[p->index].clear();
-		vector<BaseParticle *> l2 = _cells[1]->get_neigh_list(p);
-		_lists[p->index].reserve(_lists[p->index].size() + l2.size());
-		_lists[p->index].insert(_lists[p->index].end(), l2.begin(), l2.end());
+	if(!_cells.is_updated() || force_update) _cells.global_update();
 
+	for(auto p : _particles) {
+		_lists[p->index] = _cells.get_neigh_list(p);
 		_list_poss[p->index] = p->pos;
 	}
 	_updated = true;
@@ -102,10 +120,28 @@ std::vector<BaseParticle *> BinVerletList::get_neigh_list(BaseParticle *p) {
 }
 
 std::vector<BaseParticle *> BinVerletList::get_complete_neigh_list(BaseParticle *p) {
-	vector<BaseParticle *> l1 = _cells[2 * p->type]->get_complete_neigh_list(p);
-	vector<BaseParticle *> l2 = _cells[1]->get_complete_neigh_list(p);
+	return _cells.get_complete_neigh_list(p);
+}
+
+void BinVerletList::change_box() {
+	// the old positions are deformed affinely, i.e. they keep their fractional coordinates
+	LR_matrix transform = this->_box->box_matrix() * _list_inv_box;
 
-	l1.reserve(l1.size() + l2.size());
-	l1.insert(l1.end(), l2.begin(), l2.end());
-	return l1;
+	for(auto p : _particles) {
+		_list_poss[p->index] = transform * _list_poss[p->index];
+
+		if(_list_poss[p->index].sqr_distance(p->pos) > _sqr_skin) _updated = false;
+	}
+	_list_inv_box = this->_box->inverse_box_matrix();
+
+	_cells.change_box();
+	BaseList::change_box();
+}
+
+llint BinVerletList::memory_footprint() {
+	llint total = _cells.memory_footprint() + (llint) _list_poss.capacity() * sizeof(LR_vector);
+	for(auto &list : _lists) {
+		total += sizeof(list) + (llint) list.capacity() * sizeof(BaseParticle *);
+	}
+	return total;
 }
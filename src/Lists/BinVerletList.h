@@ -11,10 +11,22 @@
 #include "Cells.h"
 
 /**
- * @brief Implementation of a Verlet neighbour list.
+ * @brief Implementation of a Verlet neighbour list for multicomponent systems, where each pair of species has its own cutoff.
+ *
+ * The neighbours are found with a single set of cells whose size is set by the largest cutoff. During the cell
+ * traversal each pair is tested against the cutoff of the species it belongs to, so that the lists never have to be
+ * merged or filtered afterwards.
+ *
+ * The cutoffs are specified by bin_verlet_rcut[k], where k runs over the elements of the upper triangle of the
+ * cutoff matrix in row-major order: for two species, k = 0, 1 and 2 refer to the 0-0, 0-1 and 1-1 pairs,
+ * respectively, while for three species k = 0, 1, 2, 3, 4 and 5 refer to the 0-0, 0-1, 0-2, 1-1, 1-2 and 2-2 pairs.
+ * Pairs with a non-positive cutoff are never considered neighbours.
  *
  * @verbatim
 verlet_skin = <float> (width of the skin that controls the maximum displacement after which Verlet lists need to be updated.)
+bin_verlet_rcut[k] = <float> (cutoff of the k-th pair of species, see above. There are bin_verlet_n_species * (bin_verlet_n_species + 1) / 2 of them)
+[bin_verlet_n_species = <int> (number of species. Particle types should go from 0 to bin_verlet_n_species - 1. Defaults to 2)]
+[AO_mixture = <bool> (if true, particles of species 1 do not interact with each other, as in the Asakura-Oosawa model. Defaults to false)]
 @endverbatim
  */
 
@@ -22,15 +34,17 @@ class BinVerletList: public BaseList {
 protected:
 	std::vector<std::vector<BaseParticle *> > _lists;
 	std::vector<LR_vector > _list_poss;
+	/// inverse of the box matrix at the time of the last update, used to deform the list positions when the box changes
+	LR_matrix _list_inv_box;
 	number _skin;
 	number _sqr_skin;
 	bool _updated;
 	bool _is_AO;
 
-	number _rcut[3];
-	number _sqr_rcut[3];
-	// this has to be a vector of pointers because Cells is not copy-constructible
-	std::vector<Cells *> _cells;
+	int _N_species;
+	/// N_species x N_species matrix of the cutoffs (which include twice the skin once init() has been called)
+	std::vector<number> _rcut;
+	Cells _cells;
 
 public:
 	BinVerletList(std::vector<BaseParticle *> &ps, BaseBox *box);
@@ -45,6 +59,8 @@ public:
 	virtual void global_update(bool force_update = false);
 	virtual std::vector<BaseParticle *> get_neigh_list(BaseParticle *p);
 	virtual std::vector<BaseParticle *> get_complete_neigh_list(BaseParticle *p);
+	virtual void change_box();
+	virtual llint memory_footprint();
 };
 
 #endif /* BINVERLETLIST_H_ */
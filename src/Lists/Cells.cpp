@@ -7,57 +7,114 @@
 
 #include "Cells.h"
 
+#include "../Boxes/BoxDispatch.h"
 #include "../Utilities/ConfigInfo.h"
+#include "../Particles/Molecule.h"
 
 Cells::Cells(std::vector<BaseParticle *> &ps, BaseBox *box) :
 				BaseList(ps, box) {
-	_cells = NULL;
 	_N_cells = 0;
+	_sparse = false;
 	_N_cells_side[0] = _N_cells_side[1] = _N_cells_side[2] = 0;
 	_sqr_rcut = 0;
+	_N_pair_types = 0;
 	_allowed_type = -1;
 	_unlike_type_only = false;
 	_auto_optimisation = true;
 	_lees_edwards = false;
 	_shear_rate = 0.;
 	_dt = 0.;
+	_triclinic = false;
+	_strand_pruning = false;
+	_strand_pruning_margin = 1.;
 }
 
 Cells::~Cells() {
-	if(_cells != NULL) {
-		delete[] _cells;
-	}
+
 }
 
 void Cells::get_settings(input_file &inp) {
 	BaseList::get_settings(inp);
 	getInputBool(&inp, "cells_auto_optimisation", &_auto_optimisation, 0);
+	getInputBool(&inp, "cells_sparse", &_sparse, 0);
 	getInputBool(&inp, "lees_edwards", &_lees_edwards, 0);
 	getInputNumber(&inp, "lees_edwards_shear_rate", &_shear_rate, 0);
 	getInputNumber(&inp, "dt", &_dt, 0);
+	getInputBool(&inp, "strand_pruning", &_strand_pruning, 0);
+	getInputNumber(&inp, "strand_pruning_margin", &_strand_pruning_margin, 0);
 }
 
 void Cells::init(number rcut) {
 	BaseList::init(rcut);
 
 	_sqr_rcut = rcut * rcut;
+	_curr_step = &CONFIG_INFO->curr_step;
+
+	if(_strand_pruning) {
+		if(CONFIG_INFO->molecules().size() == 0) {
+			OX_LOG(Logger::LOG_WARNING, "(Cells.cpp) No strands found, disabling strand_pruning");
+			_strand_pruning = false;
+		}
+		else {
+			_strand_spheres.init(CONFIG_INFO->molecules(), rcut, _strand_pruning_margin);
+			_direct_strands.resize(CONFIG_INFO->molecules().size(), false);
+		}
+	}
+
+	if(_sparse) {
+		// there cannot be more occupied cells than particles
+		_sparse_heads.reserve(_particles.size());
+	}
 
 	global_update(true);
 
-	OX_LOG(Logger::LOG_INFO, "(Cells.cpp) N_cells_side: %d, %d, %d; rcut=%g, IS_MC: %d", _N_cells_side[0], _N_cells_side[1], _N_cells_side[2], this->_rcut, this->_is_MC);
+	OX_LOG(Logger::LOG_INFO, "(Cells.cpp) N_cells_side: %d, %d, %d; rcut=%g, IS_MC: %d, sparse: %d", _N_cells_side[0], _N_cells_side[1], _N_cells_side[2], this->_rcut, this->_is_MC, _sparse);
+}
+
+void Cells::set_pair_cutoffs(int N_types, const std::vector<number> &rcuts) {
+	if(rcuts.size() != (size_t) (N_types * N_types)) {
+		throw oxDNAException("Cells::set_pair_cutoffs expects %d cutoffs, found %u", N_types * N_types, rcuts.size());
+	}
+
+	_N_pair_types = N_types;
+	_sqr_pair_rcuts.resize(rcuts.size());
+	for(size_t i = 0; i < rcuts.size(); i++) {
+		_sqr_pair_rcuts[i] = (rcuts[i] > 0.) ? SQR(rcuts[i]) : -1.;
+	}
+}
+
+void Cells::_update_strand_spheres() {
+	_strand_spheres.update(this->_box);
+
+	// looping over the particles of an isolated strand is cheaper than looping over the cells if the strand is smaller
+	// than a cell, since in this case all its particles are always found in the cells that surround each of them
+	LR_vector widths = this->_box->perpendicular_widths();
+	number cell_width = std::min(widths[0] / _N_cells_side[0], std::min(widths[1] / _N_cells_side[1], widths[2] / _N_cells_side[2]));
+	for(uint i = 0; i < _direct_strands.size(); i++) {
+		number diameter = 2. * (_strand_spheres.radius(i) - _strand_pruning_margin);
+		_direct_strands[i] = _strand_spheres.isolated(i) && diameter < cell_width;
+	}
 }
 
 void Cells::_set_N_cells_side_from_box(int N_cells_side[3], BaseBox *box) {
-	LR_vector box_sides = box->box_sides();
+	// for non-orthogonal boxes the number of cells is set by the distance between opposite faces
+	LR_vector widths = box->perpendicular_widths();
 	number max_factor = pow(2. * _particles.size() / box->V(), 1. / 3.);
 	for(int i = 0; i < 3; i++) {
-		N_cells_side[i] = (int) (floor(box_sides[i] / this->_rcut) + 0.1);
-		if(_auto_optimisation && N_cells_side[i] > ceil(max_factor * box_sides[i])) N_cells_side[i] = ceil(max_factor * box_sides[i]);
+		N_cells_side[i] = (int) (floor(widths[i] / this->_rcut) + 0.1);
+		// empty cells take no memory in sparse mode, so there is no need to make the cells larger
+		if(_auto_optimisation && !_sparse && N_cells_side[i] > ceil(max_factor * widths[i])) N_cells_side[i] = ceil(max_factor * widths[i]);
 
 		if(N_cells_side[i] < 3) N_cells_side[i] = 3;
 	}
 }
 
+void Cells::change_box() {
+	BaseList::change_box();
+	_update_inv_box_sides();
+	_strand_spheres.invalidate();
+}
+
 bool Cells::is_updated() {
 	int new_N_cells_side[3];
 	_set_N_cells_side_from_box(new_N_cells_side, this->_box);
@@ -65,52 +122,59 @@ bool Cells::is_updated() {
 }
 
 void Cells::single_update(BaseParticle *p) {
-	int old_cell = _cells[p->index];
-	int new_cell = get_cell_index(p->pos);
+	llint old_cell = _cells[p->index];
+	llint new_cell = get_cell_index(p->pos);
 
 	if(old_cell != new_cell) {
 		// remove p from its old cell
 		BaseParticle *previous = P_VIRTUAL;
-		BaseParticle *current = _heads[old_cell];
+		BaseParticle *current = _head(old_cell);
 		while(current != p) {
 			previous = current;
 			current = _next[current->index];
 		}
-		if(previous == P_VIRTUAL) _heads[old_cell] = _next[p->index];
+		if(previous == P_VIRTUAL) _set_head(old_cell, _next[p->index]);
 		else _next[previous->index] = _next[p->index];
 
 		// add it to the new cell
-		_next[p->index] = _heads[new_cell];
-		_heads[new_cell] = p;
+		_next[p->index] = _head(new_cell);
+		_set_head(new_cell, p);
 
 		_cells[p->index] = new_cell;
 	}
+
+	if(_strand_pruning) {
+		_strand_spheres.check(p);
+	}
 }
 
 void Cells::global_update(bool force_update) {
 	this->_box_sides = this->_box->box_sides();
+	_update_inv_box_sides();
 	_set_N_cells_side_from_box(_N_cells_side, this->_box);
-	_N_cells = _N_cells_side[0] * _N_cells_side[1] * _N_cells_side[2];
+	_N_cells = (llint) _N_cells_side[0] * _N_cells_side[1] * _N_cells_side[2];
 
-	// we have to deallocate only if this is not the first time that this method gets called
-	if(_heads.size() > 0) {
-		_heads.clear();
-		_next.clear();
-		delete[] _cells;
+	if(_sparse) {
+		// the cost of clearing the table scales with the number of occupied cells, not with _N_cells
+		_sparse_heads.clear();
+	}
+	else {
+		_heads.assign(_N_cells, P_VIRTUAL);
 	}
-	_heads.resize(_N_cells, P_VIRTUAL);
-	_next.resize(_particles.size(), P_VIRTUAL);
-	_cells = new int[_particles.size()];
+	// particles may have been moved without calling single_update() on them (e.g. by volume moves)
+	_strand_spheres.invalidate();
+	_next.assign(_particles.size(), P_VIRTUAL);
+	_cells.assign(_particles.size(), 0);
 
 	for(uint i = 0; i < _particles.size(); i++) {
 		BaseParticle *p = this->_particles[i];
 		if(_allowed_type == -1 || p->type == _allowed_type) {
-			int cell_index = get_cell_index(p->pos);
-			if(cell_index < 0 || cell_index > _N_cells || std::isnan(cell_index) || std::isinf(cell_index)) {
-				throw oxDNAException("Invalid cell %d for particle %d (pos: %lf %lf %lf)", cell_index, p->index, p->pos[0], p->pos[1], p->pos[2]);
+			llint cell_index = get_cell_index(p->pos);
+			if(cell_index < 0 || cell_index >= _N_cells) {
+				throw oxDNAException("Invalid cell %lld for particle %d (pos: %lf %lf %lf)", cell_index, p->index, p->pos[0], p->pos[1], p->pos[2]);
 			}
-			BaseParticle *old_head = _heads[cell_index];
-			_heads[cell_index] = p;
+			BaseParticle *old_head = _head(cell_index);
+			_set_head(cell_index, p);
 			_cells[i] = cell_index;
 			_next[i] = old_head;
 		}
@@ -123,8 +187,44 @@ std::vector<BaseParticle *> Cells::_get_neigh_list(BaseParticle *p, bool all) {
 	static std::vector<BaseParticle *> res;
 	res.clear();
 
-	int cind = _cells[p->index];
-	int ind[3] = { cind % _N_cells_side[0], (cind / _N_cells_side[0]) % _N_cells_side[1], cind / (_N_cells_side[0] * _N_cells_side[1]) };
+	if(_strand_pruning && !_strand_spheres.is_updated()) {
+		_update_strand_spheres();
+	}
+
+	dispatch_box(this->_box, [this, p, all](auto box) {
+		this->_fill_neigh_list(box, p, all, res);
+	});
+
+	return res;
+}
+
+template<typename box_type>
+void Cells::_fill_neigh_list(const box_type *box, BaseParticle *p, bool all, std::vector<BaseParticle *> &res) {
+	// when per-type cutoffs are set, this points to the squared cutoffs between p's type and all the others
+	const number *sqr_pair_rcuts = (_N_pair_types > 0) ? _sqr_pair_rcuts.data() + p->type * _N_pair_types : nullptr;
+
+	auto check_and_add = [this, box, p, all, sqr_pair_rcuts, &res](BaseParticle *q) {
+		// if this is an MC simulation or all == true we need full lists, otherwise the i-th particle will have neighbours with index > i
+		bool include_q = (p != q) && (all || ((p->index > q->index || this->_is_MC)));
+		include_q = include_q && (!_unlike_type_only || p->type != q->type);
+		include_q = include_q && (!_strand_pruning || _strand_spheres.close(p->strand_id, q->strand_id));
+		number sqr_rcut = (sqr_pair_rcuts == nullptr) ? _sqr_rcut : sqr_pair_rcuts[q->type];
+		if(include_q && !p->is_bonded(q) && box->sqr_min_image_distance_direct(p->pos, q->pos) < sqr_rcut) {
+			res.push_back(q);
+		}
+	};
+
+	if(_strand_pruning && _direct_strands[p->strand_id]) {
+		for(auto q : CONFIG_INFO->molecules()[p->strand_id]->particles) {
+			if(_allowed_type == -1 || q->type == _allowed_type) {
+				check_and_add(q);
+			}
+		}
+		return;
+	}
+
+	llint cind = _cells[p->index];
+	int ind[3] = { (int) (cind % _N_cells_side[0]), (int) ((cind / _N_cells_side[0]) % _N_cells_side[1]), (int) (cind / ((llint) _N_cells_side[0] * _N_cells_side[1])) };
 	int loop_ind[3];
 
 	// y direction
@@ -138,7 +238,7 @@ std::vector<BaseParticle *> Cells::_get_neigh_list(BaseParticle *p, bool all) {
 			bool upper_edge = (ind[1] == (_N_cells_side[1] - 1)) && k == 1;
 			if(lower_edge || upper_edge) {
 				const LR_vector &L = this->_box->box_sides();
-				number delta_x = _shear_rate * L.y * _dt * CONFIG_INFO->curr_step;
+				number delta_x = _shear_rate * L.y * _dt * *_curr_step;
 				delta_x -= floor(delta_x / L.x) * L.x;
 				int c_delta_x = (delta_x / L.x) * _N_cells_side[0];
 				if(lower_edge) {
@@ -160,24 +260,22 @@ std::vector<BaseParticle *> Cells::_get_neigh_list(BaseParticle *p, bool all) {
 			// z direction
 			for(int l = -1; l < 2; l++) {
 				loop_ind[2] = (ind[2] + l + _N_cells_side[2]) % _N_cells_side[2];
-				int loop_index = loop_ind[0] + _N_cells_side[0] * (loop_ind[1] + loop_ind[2] * _N_cells_side[1]);
+				llint loop_index = loop_ind[0] + _N_cells_side[0] * (loop_ind[1] + (llint) loop_ind[2] * _N_cells_side[1]);
 
-				BaseParticle *q = _heads[loop_index];
+				BaseParticle *q = _head(loop_index);
 				while(q != P_VIRTUAL) {
-					// if this is an MC simulation or all == true we need full lists, otherwise the i-th particle will have neighbours with index > i
-					bool include_q = (p != q) && (all || ((p->index > q->index || this->_is_MC)));
-					include_q = include_q && (!_unlike_type_only || p->type != q->type);
-					if(include_q && !p->is_bonded(q) && this->_box->sqr_min_image_distance(p->pos, q->pos) < _sqr_rcut) {
-						res.push_back(q);
-					}
-
+					check_and_add(q);
 					q = _next[q->index];
 				}
 			}
 		}
 	}
+}
 
-	return res;
+llint Cells::memory_footprint() {
+	// each entry of the hash table is stored in a node that also contains a pointer to the next node of its bucket
+	llint sparse_footprint = (llint) _sparse_heads.bucket_count() * sizeof(void *) + (llint) _sparse_heads.size() * (sizeof(std::pair<llint, BaseParticle *>) + sizeof(void *));
+	return (llint) (_heads.capacity() + _next.capacity()) * sizeof(BaseParticle *) + (llint) _cells.capacity() * sizeof(llint) + sparse_footprint + _strand_spheres.memory_footprint();
 }
 
 std::vector<BaseParticle *> Cells::get_neigh_list(BaseParticle *p) {
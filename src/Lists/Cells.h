@@ -9,14 +9,32 @@
 #define CELLS_H_
 
 #include "BaseList.h"
+#include "StrandBoundingSpheres.h"
 
 #include <limits>
+#include <unordered_map>
 
 /**
  * @brief Implementation of simple simulation cells.
  *
  * Internally, this class uses linked-list to keep track of particles in order to
- * have a computational complexity of O(N).
+ * have a computational complexity of O(N). Cells are built in fractional coordinates, so that non-orthogonal
+ * (triclinic) boxes are split into parallelepipeds whose perpendicular widths are at least as large as rcut.
+ *
+ * If strand_pruning is enabled, particles that belong to strands whose bounding spheres (see StrandBoundingSpheres)
+ * are too far apart are not considered neighbours, and the neighbours of particles that belong to small isolated
+ * strands are looked for among the particles of the same strand only, without traversing the cells.
+ *
+ * If cells_sparse is enabled, only the cells that contain at least one particle are stored (in a hash table), so that
+ * memory usage and rebuild times scale with the number of particles rather than with the volume of the box. This is
+ * useful for very large and dilute boxes, where most of the cells are empty.
+ *
+ * @verbatim
+[cells_auto_optimisation = <bool> (if true, the number of cells is capped so that each cell contains, on average, at least half a particle. Ignored if cells_sparse is true. Defaults to true)]
+[cells_sparse = <bool> (if true, only the occupied cells are stored, which makes it possible to use cells as small as the cutoff in very large, dilute boxes. Defaults to false)]
+[strand_pruning = <bool> (if true, the bounding spheres of the strands are used to skip pairs of particles that belong to strands that are far apart. Useful in dilute systems. Defaults to false)]
+[strand_pruning_margin = <float> (how much the bounding spheres of the strands are inflated, which sets how far particles can move before they need to be recomputed. Defaults to 1)]
+@endverbatim
  */
 
 class Cells: public BaseList {
@@ -25,17 +43,88 @@ protected:
 	bool _unlike_type_only;
 	std::vector<BaseParticle *> _heads;
 	std::vector<BaseParticle *> _next;
-	int *_cells;
-	int _N_cells;
+	std::vector<llint> _cells;
+	llint _N_cells;
+	/// if true, the heads of the occupied cells are stored in _sparse_heads, and _heads is left empty
+	bool _sparse;
+	std::unordered_map<llint, BaseParticle *> _sparse_heads;
 	int _N_cells_side[3];
 	number _sqr_rcut;
+	/// if not empty, the _N_pair_types x _N_pair_types matrix of the squared cutoffs of each pair of particle types, which overrides _sqr_rcut
+	std::vector<number> _sqr_pair_rcuts;
+	int _N_pair_types;
 	bool _auto_optimisation;
 	bool _lees_edwards;
 	number _shear_rate;
 	number _dt;
+	/// pointer to the current step, which sets the shift between the periodic images along y when Lees-Edwards conditions are enabled
+	const llint *_curr_step = nullptr;
+
+	bool _strand_pruning;
+	number _strand_pruning_margin;
+	StrandBoundingSpheres _strand_spheres;
+	/// true for the strands whose particles' neighbours can be found by looping over the strand rather than over the cells
+	std::vector<bool> _direct_strands;
+
+	/**
+	 * @brief Recomputes the bounding spheres of the strands and decides for which strands the cells can be skipped.
+	 */
+	void _update_strand_spheres();
+
+	/// inverse of the box sides, used to avoid divisions in get_cell_index
+	LR_vector _inv_box_sides;
+	/// true if the box is not orthogonal, in which case cells are built in fractional coordinates through _inv_box
+	bool _triclinic;
+	LR_matrix _inv_box;
+
+	void _update_inv_box_sides() {
+		_inv_box_sides = LR_vector(1. / this->_box_sides.x, 1. / this->_box_sides.y, 1. / this->_box_sides.z);
+		_triclinic = (this->_box->geometry() == BaseBox::TRICLINIC);
+		if(_triclinic) {
+			_inv_box = this->_box->inverse_box_matrix();
+		}
+	}
+
+	/// returns the fractional coordinates of the given position
+	inline LR_vector _fractional(const LR_vector &pos) const {
+		if(_triclinic) {
+			return _inv_box * pos;
+		}
+		return LR_vector(pos.x * _inv_box_sides.x, pos.y * _inv_box_sides.y, pos.z * _inv_box_sides.z);
+	}
+
+	/// returns the first particle of the given cell, or P_VIRTUAL if the cell is empty
+	inline BaseParticle *_head(llint cell) const {
+		if(_sparse) {
+			auto it = _sparse_heads.find(cell);
+			return (it == _sparse_heads.end()) ? P_VIRTUAL : it->second;
+		}
+		return _heads[cell];
+	}
+
+	/// sets the first particle of the given cell. In sparse mode, cells that become empty are removed from the table
+	inline void _set_head(llint cell, BaseParticle *p) {
+		if(_sparse) {
+			if(p == P_VIRTUAL) {
+				_sparse_heads.erase(cell);
+			}
+			else {
+				_sparse_heads[cell] = p;
+			}
+		}
+		else {
+			_heads[cell] = p;
+		}
+	}
 
 	void _set_N_cells_side_from_box(int N_cells_side[3], BaseBox *box);
 	std::vector<BaseParticle *> _get_neigh_list(BaseParticle *p, bool all);
+
+	/**
+	 * @brief Appends to res the neighbours of p. The box is passed with its concrete type, so that the minimum image convention can be inlined.
+	 */
+	template<typename box_type>
+	void _fill_neigh_list(const box_type *box, BaseParticle *p, bool all, std::vector<BaseParticle *> &res);
 public:
 	Cells(std::vector<BaseParticle *> &ps, BaseBox *box);
 	Cells() = delete;
@@ -53,14 +142,28 @@ public:
 	virtual void set_allowed_type(int type) { _allowed_type = type; }
 	virtual void set_unlike_type_only() { _unlike_type_only = true; }
 
-	virtual int get_N_cells() { return _N_cells; }
-	inline int get_cell_index(const LR_vector &pos);
+	/**
+	 * @brief Sets a different cutoff for each pair of particle types. Pairs with a non-positive cutoff are never neighbours.
+	 *
+	 * The cutoff passed to init() sets the size of the cells and hence it should be at least as large as the largest of these cutoffs.
+	 *
+	 * @param N_types number of particle types. Types should go from 0 to N_types - 1
+	 * @param rcuts N_types x N_types matrix, stored in row-major order
+	 */
+	virtual void set_pair_cutoffs(int N_types, const std::vector<number> &rcuts);
+
+	virtual void change_box();
+
+	virtual llint get_N_cells() { return _N_cells; }
+	virtual llint memory_footprint();
+	inline llint get_cell_index(const LR_vector &pos);
 };
 
-inline int Cells::get_cell_index(const LR_vector &pos) {
-	int res = (int) ((pos.x / this->_box_sides.x - floor(pos.x / this->_box_sides.x)) * (1. - std::numeric_limits<number>::epsilon())*_N_cells_side[0]);
-	res += _N_cells_side[0]*((int) ((pos.y / this->_box_sides.y - floor(pos.y / this->_box_sides.y))*(1. - std::numeric_limits<number>::epsilon())*_N_cells_side[1]));
-	res += _N_cells_side[0]*_N_cells_side[1]*((int) ((pos.z / this->_box_sides.z - floor(pos.z / this->_box_sides.z))*(1. - std::numeric_limits<number>::epsilon())*_N_cells_side[2]));
+inline llint Cells::get_cell_index(const LR_vector &pos) {
+	LR_vector s = _fractional(pos);
+	llint res = (llint) ((s.x - floor(s.x)) * (1. - std::numeric_limits<number>::epsilon())*_N_cells_side[0]);
+	res += (llint) _N_cells_side[0]*((llint) ((s.y - floor(s.y))*(1. - std::numeric_limits<number>::epsilon())*_N_cells_side[1]));
+	res += (llint) _N_cells_side[0]*_N_cells_side[1]*((llint) ((s.z - floor(s.z))*(1. - std::numeric_limits<number>::epsilon())*_N_cells_side[2]));
 	return res;
 }
 
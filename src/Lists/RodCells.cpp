@@ -12,31 +12,22 @@
 
 RodCells::RodCells(std::vector<BaseParticle *> &ps, BaseBox *box) :
 				BaseList(ps, box) {
-	_heads = NULL;
-	_next = NULL;
-	_cells = NULL;
 	_N_cells = 0;
 	_N_cells_side[0] = _N_cells_side[1] = _N_cells_side[2] = 0;
+	_cell_capacity = 0;
 	_sqr_rcut = 0;
 	_rod_cell_rcut = (number) 0.f;
 	_rod_length = (number) -1.f;
 	_rod_length_2 = (number) -1.f;
-	_n_virtual_sites = NULL;
 	_max_size = 20;
-	_added = std::vector<bool>();
 	_n_part_types = 1;
 	_n_virtual_sites_max = -1;
 	_restrict_to_type = -1;
-	//_neighs = std::unordered_set<int> ();
-	//_neighs = std::set<int> ();
-	//_neighs = std::list<int> ();
+	_current_stamp = 0;
 }
 
 RodCells::~RodCells() {
-	if(_heads != NULL) delete[] _heads;
-	if(_next != NULL) delete[] _next;
-	if(_cells != NULL) delete[] _cells;
-	if(_n_virtual_sites != NULL) delete[] _n_virtual_sites;
+
 }
 
 void RodCells::get_settings(input_file &inp){
@@ -53,28 +44,25 @@ void RodCells::init(number rcut) {
 
 	_sqr_rcut = rcut * rcut;
 
-	_n_virtual_sites = new int[_n_part_types];
-	_n_virtual_sites[0] = 1;
-	while((_rod_length / _n_virtual_sites[0]) + (number) 0.01 >= _rod_cell_rcut)
-		_n_virtual_sites[0] += 1;
-
-	if(_n_part_types == 2) {
-		if (_rod_length_2 < 0.) throw oxDNAException("(RodCells.cpp) Can't run with 2 particle types and no _rod_length_2");
-		_n_virtual_sites[1] = 1;
-		while((_rod_length_2 / _n_virtual_sites[1]) + (number) 0.01 >= _rod_cell_rcut)
-			_n_virtual_sites[1] += 1;
-	}
-
 	if(_n_part_types > 2) throw oxDNAException("RodCells.ccp can handle at most 2 particle types for now");
+	if(_n_part_types == 2 && _rod_length_2 < 0.) throw oxDNAException("(RodCells.cpp) Can't run with 2 particle types and no _rod_length_2");
+
+	// the number of sites of the second species is always computed, since it enters the size of the cells
+	_n_virtual_sites.resize(2);
+	number lengths[2] = {_rod_length, _rod_length_2};
+	for(int i = 0; i < 2; i++) {
+		_n_virtual_sites[i] = 1;
+		while((lengths[i] / _n_virtual_sites[i]) + (number) 0.01 >= _rod_cell_rcut)
+			_n_virtual_sites[i] += 1;
+	}
 
 	for(uint i = 0; i < _particles.size(); i++) {
 		if(_particles[i]->type >= _n_part_types) throw oxDNAException("Found particle with index %d and type %d, but RodCell is set up with only %d particle types", _particles[i]->index, _particles[i]->type, _n_part_types);
 	}
 
-	_n_virtual_sites_max = _n_virtual_sites[0] > _n_virtual_sites[1] ? _n_virtual_sites[0] : _n_virtual_sites[1];
+	_n_virtual_sites_max = (_n_part_types == 2) ? std::max(_n_virtual_sites[0], _n_virtual_sites[1]) : _n_virtual_sites[0];
 
-	for(uint i = 0; i < _particles.size(); i++)
-		_added.push_back(false);
+	_stamps.resize(_particles.size(), 0);
 
 	global_update(true);
 
@@ -82,9 +70,8 @@ void RodCells::init(number rcut) {
 }
 
 void RodCells::_set_N_cells_side_from_box(int N_cells_side[3], BaseBox *box) {
-	LR_vector box_sides = box->box_sides();  // TODO: perhaps use pointer instead of copying?
+	LR_vector box_sides = box->box_sides();
 	number my_rcut = _rod_cell_rcut + _rod_length / 2.f / _n_virtual_sites[0] + _rod_length_2 / 2.f / _n_virtual_sites[1];
-	//OX_LOG(Logger::LOG_INFO, "(RodCells.cpp) myrcut: %g (%g %g)", my_rcut, + _rod_length / 2.f / _n_virtual_sites[0], + _rod_length_2 / 2.f / _n_virtual_sites[1]);
 	for(int i = 0; i < 3; i++) {
 		N_cells_side[i] = (int) (floor(box_sides[i] / my_rcut) + 0.1);
 		if(N_cells_side[i] < 3) N_cells_side[i] = 3;
@@ -102,87 +89,115 @@ bool RodCells::is_updated() {
 	return (new_N_cells_side[0] == _N_cells_side[0] && new_N_cells_side[1] == _N_cells_side[1] && new_N_cells_side[2] == _N_cells_side[2]);
 }
 
-void RodCells::single_update(BaseParticle *p) {
-
-	//if (_restrict_to_type >= 0 && p->type != _restrict_to_type) return;
-
-	// remove from old cells
-	for(int k = 0; k < _n_virtual_sites[p->type]; k++) {
-		int site_idx = p->index * _n_virtual_sites_max + k;
-		int old_cell = _cells[site_idx];
-
-		int previous = -1;
-		int current = _heads[old_cell];
-		while(current != site_idx) {
-			previous = current;
-			current = _next[current];
-		}
-		if(previous == -1) _heads[old_cell] = _next[site_idx];
-		else _next[previous] = _next[site_idx];
-	}
-
-	// compute new cell indexes and add to new cells
-	LR_vector * r = &p->pos;
-	LR_vector * u = &p->orientation.v3;
-	number s = (_rod_length / (_n_virtual_sites[p->type]));
-	LR_vector stride = s * (*u);
-	LR_vector site_pos = (*r) - (0.5f * _rod_length + 0.5f * s) * (*u);
-	if(_n_virtual_sites[p->type] < 2) site_pos = *r;
-	for(int k = 0; k < _n_virtual_sites[p->type]; k++) {
-		int site_idx = p->index * _n_virtual_sites_max + k;
-		int new_cell = get_cell_index(site_pos);
-		_cells[site_idx] = new_cell;
-		_next[site_idx] = _heads[new_cell];
-		_heads[new_cell] = site_idx;
+void RodCells::change_box() {
+	BaseList::change_box();
+	_inv_box_sides = LR_vector(1. / this->_box_sides.x, 1. / this->_box_sides.y, 1. / this->_box_sides.z);
+}
 
-		site_pos += stride;
+uint RodCells::_next_stamp() {
+	_current_stamp++;
+	if(_current_stamp == 0) {
+		std::fill(_stamps.begin(), _stamps.end(), 0);
+		_current_stamp = 1;
 	}
-
-	return;
+	return _current_stamp;
 }
 
-void RodCells::global_update(bool force_update) {
-	this->_box_sides = this->_box->box_sides();
-	_set_N_cells_side_from_box(_N_cells_side, this->_box);
-	_N_cells = _N_cells_side[0] * _N_cells_side[1] * _N_cells_side[2];
+void RodCells::_site_positions(BaseParticle *p, LR_vector &first, LR_vector &stride) {
+	// the sites are evenly spaced and placed symmetrically with respect to the centre of the rod
+	const LR_vector &u = p->orientation.v3;
+	number length = (p->type == 0) ? _rod_length : _rod_length_2;
+	number s = (length / (_n_virtual_sites[p->type]));
+	stride = s * u;
+	if(_n_virtual_sites[p->type] < 2) first = p->pos;
+	else first = p->pos - (0.5f * length - 0.5f * s) * u;
+}
 
-	// we have to deallocate only if this is not the first time that this method gets called
-	if(_heads != NULL) {
-		delete[] _heads;
-		delete[] _next;
-		delete[] _cells;
+bool RodCells::_add_to_cell(int cell, int m) {
+	int &count = _cell_count[cell];
+	if(count == _cell_capacity) {
+		return false;
 	}
-	_heads = new int[_N_cells];
-	_cells = new int[_particles.size() * _n_virtual_sites_max];
-	_next = new int[_particles.size() * _n_virtual_sites_max];
+	_cell_sites[cell * _cell_capacity + count] = m;
+	count++;
+	return true;
+}
 
-	for(int i = 0; i < _N_cells; i++) {
-		_heads[i] = -1;
+void RodCells::_remove_from_cell(int cell, int m) {
+	// the order of the sites in a cell does not matter, so that we can replace the removed site with the last one
+	int *sites = _cell_sites.data() + cell * _cell_capacity;
+	int &count = _cell_count[cell];
+	for(int i = 0; i < count; i++) {
+		if(sites[i] == m) {
+			sites[i] = sites[count - 1];
+			count--;
+			return;
+		}
 	}
+}
 
-	for(uint i = 0; i < _particles.size() * _n_virtual_sites_max; i++) {
-		_next[i] = -1;
-	}
+void RodCells::_fill_cells() {
+	_cell_count.assign(_N_cells, 0);
 
 	for(uint i = 0; i < _particles.size(); i++) {
 		BaseParticle *p = this->_particles[i];
-		//if (_restrict_to_type >= 0 && p->type != _restrict_to_type) continue;
-		// FIX HERE with new stride
-		LR_vector * r = &p->pos;
-		LR_vector * u = &p->orientation.v3;
-		number s = (_rod_length / (_n_virtual_sites[p->type]));
-		LR_vector stride = s * (*u);
-		LR_vector site_pos = (*r) - (0.5f * _rod_length + 0.5f * s) * (*u);
-		if(_n_virtual_sites[p->type] < 2) site_pos = p->pos;
+		LR_vector site_pos, stride;
+		_site_positions(p, site_pos, stride);
 		for(int k = 0; k < _n_virtual_sites[p->type]; k++) {
 			int site_idx = i * _n_virtual_sites_max + k;
 			int cell_index = get_cell_index(site_pos);
 			_cells[site_idx] = cell_index;
-			_next[site_idx] = _heads[cell_index];
-			_heads[cell_index] = site_idx;
+			_cell_count[cell_index]++;
 			site_pos += stride;
 		}
 	}
+
+	// leave some room, so that sites can change cell without triggering a rebuild
+	int max_count = *std::max_element(_cell_count.begin(), _cell_count.end());
+	_cell_capacity = std::max(_cell_capacity, 2 * max_count);
+	_cell_sites.resize((size_t) _N_cells * _cell_capacity);
+
+	_cell_count.assign(_N_cells, 0);
+	for(uint i = 0; i < _particles.size(); i++) {
+		BaseParticle *p = this->_particles[i];
+		for(int k = 0; k < _n_virtual_sites[p->type]; k++) {
+			_add_to_cell(_cells[i * _n_virtual_sites_max + k], i);
+		}
+	}
+}
+
+void RodCells::single_update(BaseParticle *p) {
+	LR_vector site_pos, stride;
+	_site_positions(p, site_pos, stride);
+	for(int k = 0; k < _n_virtual_sites[p->type]; k++) {
+		int site_idx = p->index * _n_virtual_sites_max + k;
+		int old_cell = _cells[site_idx];
+		int new_cell = get_cell_index(site_pos);
+
+		if(new_cell != old_cell) {
+			_remove_from_cell(old_cell, p->index);
+			_cells[site_idx] = new_cell;
+			if(!_add_to_cell(new_cell, p->index)) {
+				// the cell is full: rebuild everything with more room
+				_fill_cells();
+				return;
+			}
+		}
+
+		site_pos += stride;
+	}
+}
+
+void RodCells::global_update(bool force_update) {
+	this->_box_sides = this->_box->box_sides();
+	_inv_box_sides = LR_vector(1. / this->_box_sides.x, 1. / this->_box_sides.y, 1. / this->_box_sides.z);
+	_set_N_cells_side_from_box(_N_cells_side, this->_box);
+	_N_cells = _N_cells_side[0] * _N_cells_side[1] * _N_cells_side[2];
+
+	_cells.resize(_particles.size() * _n_virtual_sites_max, -1);
+	// the occupation of the cells depends on their number, so that the capacity has to be recomputed from scratch
+	_cell_capacity = 0;
+	_fill_cells();
 }
 
 std::vector<BaseParticle *> RodCells::_get_neigh_list(BaseParticle *p, bool all) {
@@ -196,13 +211,9 @@ std::vector<BaseParticle *> RodCells::_get_neigh_list(BaseParticle *p, bool all)
 
 	res.reserve(_max_size);
 
-	//_neighs.clear();
-	//typename std::unordered_set<int>::iterator it = _neighs.begin();
-	//typename std::set<int>::iterator it = _neighs.begin();
-	//typename std::vector<BaseParticle *>::iterator it = res.begin();
-	//typename std::list<int>::iterator it;
-
-	int last_inserted = -4;
+	uint stamp = _next_stamp();
+	// p should never be added to its own list
+	_stamps[p->index] = stamp;
 
 	for(int s = 0; s < _n_virtual_sites[p->type]; s++) {
 		int site_idx = p->index * _n_virtual_sites_max + s;
@@ -221,36 +232,16 @@ std::vector<BaseParticle *> RodCells::_get_neigh_list(BaseParticle *p, bool all)
 					if(loop_ind[2] < 0) loop_ind[2] += _N_cells_side[2];
 					int other_cell_index = loop_ind[0] + _N_cells_side[0] * (loop_ind[1] + _N_cells_side[1] * loop_ind[2]);
 
-					int n = _heads[other_cell_index];
-
-					/*
-					 // this cycle works well with sets
-					 while (n != -1) {
-					 //_neighs.insert(n / _n_virtual_sites); // simple version
-					 it = _neighs.insert(it, n / _n_virtual_sites);
-					 n = _next[n];
-					 }
-
-					 // cycle to work with lists
-					 while (n != -1) {
-					 _neighs.push_back(n / _n_virtual_sites);
-					 n = _next[n];
-					 }*/
-
-					while(n != -1) {
-						int m = n / _n_virtual_sites_max;
-						if(m != p->index && m != last_inserted) {
-							if(all || this->_is_MC || p->index > m) {
-								if(want_type < 0 || this->_particles[m]->type == want_type) {
-									if(_added[m] == false) {
-										res.push_back(this->_particles[m]);
-										last_inserted = m;
-										_added[m] = true;
-									}
-								}
+					const int *sites = _cell_sites.data() + (size_t) other_cell_index * _cell_capacity;
+					int count = _cell_count[other_cell_index];
+					for(int n = 0; n < count; n++) {
+						int m = sites[n];
+						if(_stamps[m] != stamp && (all || this->_is_MC || p->index > m)) {
+							if(want_type < 0 || this->_particles[m]->type == want_type) {
+								res.push_back(this->_particles[m]);
+								_stamps[m] = stamp;
 							}
 						}
-						n = _next[n];
 					}
 				}
 			}
@@ -260,43 +251,8 @@ std::vector<BaseParticle *> RodCells::_get_neigh_list(BaseParticle *p, bool all)
 	if(res.size() > _max_size) {
 		// this will adjust the size of the reserved vector
 		_max_size = res.size();
-		//printf ("## new size: %d\n", (int) _max_size );
 	}
 
-	// sort the vector and then let unique do the magic
-	//std::sort(res.begin(), res.end());
-	//res.erase(std::unique(res.begin(), res.end()), res.end());
-
-	typename std::vector<BaseParticle *>::iterator it;
-	for(it = res.begin(); it != res.end(); ++it)
-		_added[(*it)->index] = false;
-
-	/*
-	 // this was needed for ordered sets
-	 for (it = _neighs.begin(); it != _neighs.end(); it ++) {
-	 if (*it == p->index)
-	 continue;
-	 if (all || this->_is_MC || p->index > *it) {
-	 //if (this->_box->sqr_min_image_distance(p->pos, this->_particles[*it]->pos) < _sqr_rcut)
-	 res.push_back(this->_particles[*it]);
-	 }
-	 }
-
-	 //lists
-	 _neighs.sort();
-	 last_inserted = -4;
-	 for (it = _neighs.begin(); it != _neighs.end(); it ++) {
-	 if (*it == p->index || *it == last_inserted)
-	 continue;
-
-	 if (all || this->_is_MC || p->index > *it) {
-	 //if (this->_box->sqr_min_image_distance(p->pos, this->_particles[*it]->pos) < _sqr_rcut)
-	 res.push_back(this->_particles[*it]);
-	 last_inserted = *it;
-	 }
-	 }
-	 */
-
 	return res;
 }
 
@@ -306,6 +262,8 @@ std::vector<BaseParticle *> RodCells::whos_there(int idx) {
 	std::vector<BaseParticle *> res;
 	res.reserve(_max_size);
 
+	uint stamp = _next_stamp();
+
 	int ind[3] = { idx % _N_cells_side[0], (idx / _N_cells_side[0]) % _N_cells_side[1], idx / (_N_cells_side[0] * _N_cells_side[1]) };
 
 	int loop_ind[3];
@@ -320,27 +278,26 @@ std::vector<BaseParticle *> RodCells::whos_there(int idx) {
 				if(loop_ind[2] < 0) loop_ind[2] += _N_cells_side[2];
 				int other_cell_index = loop_ind[0] + _N_cells_side[0] * (loop_ind[1] + _N_cells_side[1] * loop_ind[2]);
 
-				int n = _heads[other_cell_index];
-
-				while(n != -1) {
-					int m = n / _n_virtual_sites_max;
-					if(_added[m] == false) {
+				const int *sites = _cell_sites.data() + (size_t) other_cell_index * _cell_capacity;
+				int count = _cell_count[other_cell_index];
+				for(int n = 0; n < count; n++) {
+					int m = sites[n];
+					if(_stamps[m] != stamp) {
 						res.push_back(this->_particles[m]);
-						_added[m] = true;
+						_stamps[m] = stamp;
 					}
-					n = _next[n];
 				}
 			}
 		}
 	}
 
-	typename std::vector<BaseParticle *>::iterator it;
-	for(it = res.begin(); it != res.end(); ++it)
-		_added[(*it)->index] = false;
-
 	return res;
 }
 
+llint RodCells::memory_footprint() {
+	return (llint) (_cells.capacity() + _cell_sites.capacity() + _cell_count.capacity()) * sizeof(int) + (llint) _stamps.capacity() * sizeof(uint);
+}
+
 std::vector<BaseParticle *> RodCells::get_neigh_list(BaseParticle *p) {
 	return _get_neigh_list(p, false);
 }
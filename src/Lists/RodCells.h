@@ -12,43 +12,78 @@
 
 #include <limits>
 #include <vector>
-//#include <set>
-//#include <unordered_set>
-//#include <list>
 
 /**
- * @brief Implementation of simple simulation cells.
+ * @brief Cells for elongated particles (rods), which are represented by a number of virtual sites placed along their axes.
  *
- * Internally, this class uses linked-list to keep track of particles in order to
- * have a computational complexity of O(N).
+ * The virtual sites of each cell are stored contiguously: each cell owns a fixed number of slots in a single array,
+ * and the number of slots is increased (which triggers a full rebuild) only when a cell overflows. As a result,
+ * single_update() only touches the sites that have changed cell, and moving a few rods does not require rebuilding
+ * the whole structure. Since a rod can have several sites close to the same cell, neighbours are deduplicated by
+ * "stamping" each particle with the id of the current query, so that no per-query clean-up is required.
+ *
+ * @verbatim
+rod_cell_rcut = <float> (maximum distance between virtual sites that are considered neighbours)
+rod_length = <float> (length of the rods)
+rod_length_2 = <float> (length of the rods of the second species)
+[rod_cell_n_part_types = <int> (number of rod species, either 1 or 2. Defaults to 1)]
+[rod_cell_restrict_to_type = <int> (if set, particles of any other type will have only particles of this type as neighbours)]
+@endverbatim
  */
 
 class RodCells: public BaseList {
 protected:
-	int * _heads;
-	int * _next;
-	int *_cells;
+	/// for each site, the index of the cell it belongs to
+	std::vector<int> _cells;
 	int _N_cells;
 	int _N_cells_side[3];
 
+	/// number of slots available for each cell in _cell_sites
+	int _cell_capacity;
+	/// the particles whose virtual sites are in each cell: the sites of cell i are stored in [i * _cell_capacity, i * _cell_capacity + _cell_count[i])
+	std::vector<int> _cell_sites;
+	std::vector<int> _cell_count;
+
 	size_t _max_size;
 
 	number _sqr_rcut;
 
 	number _rod_cell_rcut;
 	number _rod_length, _rod_length_2;
-	int * _n_virtual_sites;
+	std::vector<int> _n_virtual_sites;
 	int _n_part_types;
 	int _n_virtual_sites_max;
 	int _restrict_to_type;
 
-	//std::set<int> _neighs;
-	//std::unordered_set<int> _neighs; // unordered_set are measurably and consistently faster than the other options, but slower than sorting the resulting vector
-	//std::list<int> _neighs;
-	std::vector<bool> _added;
+	/// a particle has already been added to the result of the current query if its stamp is equal to _current_stamp
+	std::vector<uint> _stamps;
+	uint _current_stamp;
+
+	LR_vector _inv_box_sides;
 
 	void _set_N_cells_side_from_box(int N_cells_side[3], BaseBox *box);
 	std::vector<BaseParticle *> _get_neigh_list(BaseParticle *p, bool all);
+
+	/**
+	 * @brief Returns a new stamp, resetting all the stamps when the counter wraps around.
+	 */
+	uint _next_stamp();
+
+	/**
+	 * @brief Returns the position of the first virtual site of p and the vector that connects two consecutive sites.
+	 */
+	void _site_positions(BaseParticle *p, LR_vector &first, LR_vector &stride);
+
+	/**
+	 * @brief Adds particle m to the given cell. Returns false if the cell is full.
+	 */
+	bool _add_to_cell(int cell, int m);
+	void _remove_from_cell(int cell, int m);
+
+	/**
+	 * @brief Fills the cells from scratch, increasing the capacity of the cells until all the sites fit.
+	 */
+	void _fill_cells();
 public:
 	RodCells(std::vector<BaseParticle *> &ps, BaseBox *box);
 	RodCells() = delete;
@@ -62,17 +97,19 @@ public:
 	virtual void global_update(bool force_update=false);
 	virtual std::vector<BaseParticle *> get_neigh_list(BaseParticle *p);
 	virtual std::vector<BaseParticle *> get_complete_neigh_list(BaseParticle *p);
+	virtual void change_box();
 
 	std::vector<BaseParticle * > whos_there(int idx);
-	
+
 	virtual int get_N_cells() { return _N_cells; }
+	virtual llint memory_footprint();
 	inline int get_cell_index(const LR_vector &pos);
 };
 
 inline int RodCells::get_cell_index(const LR_vector &pos) {
-	int res = (int) ((pos.x / this->_box_sides.x - floor(pos.x / this->_box_sides.x)) * (1. - std::numeric_limits<number>::epsilon())*_N_cells_side[0]);
-	res += _N_cells_side[0]*((int) ((pos.y / this->_box_sides.y - floor(pos.y / this->_box_sides.y))*(1. - std::numeric_limits<number>::epsilon())*_N_cells_side[1]));
-	res += _N_cells_side[0]*_N_cells_side[1]*((int) ((pos.z / this->_box_sides.z - floor(pos.z / this->_box_sides.z))*(1. - std::numeric_limits<number>::epsilon())*_N_cells_side[2]));
+	int res = (int) ((pos.x * _inv_box_sides.x - floor(pos.x * _inv_box_sides.x)) * (1. - std::numeric_limits<number>::epsilon())*_N_cells_side[0]);
+	res += _N_cells_side[0]*((int) ((pos.y * _inv_box_sides.y - floor(pos.y * _inv_box_sides.y))*(1. - std::numeric_limits<number>::epsilon())*_N_cells_side[1]));
+	res += _N_cells_side[0]*_N_cells_side[1]*((int) ((pos.z * _inv_box_sides.z - floor(pos.z * _inv_box_sides.z))*(1. - std::numeric_limits<number>::epsilon())*_N_cells_side[2]));
 	return res;
 }
 
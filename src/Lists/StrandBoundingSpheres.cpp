@@ -0,0 +1,69 @@
+/*
+ * StrandBoundingSpheres.cpp
+ */
+
+#include "StrandBoundingSpheres.h"
+
+#include "../Boxes/BaseBox.h"
+#include "../Particles/Molecule.h"
+
+StrandBoundingSpheres::StrandBoundingSpheres() :
+				_molecules(nullptr),
+				_N_strands(0),
+				_rcut(0.),
+				_margin(0.),
+				_updated(false) {
+
+}
+
+StrandBoundingSpheres::~StrandBoundingSpheres() {
+
+}
+
+void StrandBoundingSpheres::init(std::vector<std::shared_ptr<Molecule>> &molecules, number rcut, number margin) {
+	_molecules = &molecules;
+	_N_strands = molecules.size();
+	_rcut = rcut;
+	_margin = margin;
+
+	_centres.resize(_N_strands);
+	_sqr_radii.resize(_N_strands);
+	_close.resize(_N_strands * _N_strands);
+	_isolated.resize(_N_strands);
+	_updated = false;
+}
+
+void StrandBoundingSpheres::update(BaseBox *box) {
+	std::vector<number> radii(_N_strands, 0.);
+	for(int i = 0; i < _N_strands; i++) {
+		auto mol = (*_molecules)[i];
+		// the particles may have moved since the last time the properties have been computed
+		mol->invalidate();
+		mol->update_properties();
+		_centres[i] = mol->com;
+		radii[i] = mol->bounding_radius + _margin;
+		_sqr_radii[i] = SQR(radii[i]);
+	}
+
+	for(int i = 0; i < _N_strands; i++) {
+		_close[i * _N_strands + i] = true;
+		_isolated[i] = true;
+	}
+
+	for(int i = 0; i < _N_strands; i++) {
+		for(int j = i + 1; j < _N_strands; j++) {
+			number max_distance = radii[i] + radii[j] + _rcut;
+			bool close = box->sqr_min_image_distance(_centres[i], _centres[j]) < SQR(max_distance);
+			_close[i * _N_strands + j] = _close[j * _N_strands + i] = close;
+			if(close) {
+				_isolated[i] = _isolated[j] = false;
+			}
+		}
+	}
+
+	_updated = true;
+}
+
+llint StrandBoundingSpheres::memory_footprint() const {
+	return (llint) _centres.capacity() * sizeof(LR_vector) + (llint) _sqr_radii.capacity() * sizeof(number) + (llint) (_close.capacity() + _isolated.capacity()) / 8;
+}
@@ -0,0 +1,101 @@
+/*
+ * StrandBoundingSpheres.h
+ */
+
+#ifndef STRANDBOUNDINGSPHERES_H_
+#define STRANDBOUNDINGSPHERES_H_
+
+#include "../defs.h"
+
+#include <memory>
+#include <vector>
+
+class BaseBox;
+class BaseParticle;
+struct Molecule;
+
+/**
+ * @brief Keeps track of the spheres that enclose each strand (molecule) and of the pairs of strands that may interact.
+ *
+ * Each sphere is centred in the centre of mass of its strand and its radius is the largest distance between a
+ * particle and the centre of mass plus a margin, so that particles can move a bit before the spheres need to be
+ * recomputed. Two strands are "close" if the (minimum image) distance between their centres is smaller than the sum
+ * of their radii plus the cutoff. If two strands are not close, none of their particles can be closer than the cutoff.
+ *
+ * This is used to skip the particle-level search for pairs that belong to far-away strands, which is useful in dilute
+ * systems. The table of close strands is built by looping over all the pairs of strands, so this is meant for
+ * systems with at most a few thousand strands.
+ */
+class StrandBoundingSpheres {
+protected:
+	std::vector<std::shared_ptr<Molecule>> *_molecules;
+	int _N_strands;
+	number _rcut;
+	number _margin;
+	bool _updated;
+
+	std::vector<LR_vector> _centres;
+	std::vector<number> _sqr_radii;
+	/// _N_strands x _N_strands table, true if the two strands may have particles closer than _rcut
+	std::vector<bool> _close;
+	/// true if the strand is not close to any other strand
+	std::vector<bool> _isolated;
+
+public:
+	StrandBoundingSpheres();
+	virtual ~StrandBoundingSpheres();
+
+	void init(std::vector<std::shared_ptr<Molecule>> &molecules, number rcut, number margin);
+
+	/**
+	 * @brief Recomputes the spheres and the table of close strands.
+	 */
+	void update(BaseBox *box);
+
+	/**
+	 * @brief Returns true if p is inside the sphere of its strand.
+	 */
+	inline bool contains(BaseParticle *p) const;
+
+	/**
+	 * @brief Flags the spheres as outdated if p is no longer inside the sphere of its strand.
+	 */
+	void check(BaseParticle *p) {
+		if(!contains(p)) {
+			_updated = false;
+		}
+	}
+
+	/**
+	 * @brief Flags the spheres as outdated, which should be done whenever particles are moved without calling check() on them.
+	 */
+	void invalidate() {
+		_updated = false;
+	}
+
+	bool is_updated() const {
+		return _updated;
+	}
+
+	number radius(int strand) const {
+		return sqrt(_sqr_radii[strand]);
+	}
+
+	bool close(int strand_1, int strand_2) const {
+		return _close[strand_1 * _N_strands + strand_2];
+	}
+
+	bool isolated(int strand) const {
+		return _isolated[strand];
+	}
+
+	llint memory_footprint() const;
+};
+
+#include "../Particles/BaseParticle.h"
+
+inline bool StrandBoundingSpheres::contains(BaseParticle *p) const {
+	return p->pos.sqr_distance(_centres[p->strand_id]) <= _sqr_radii[p->strand_id];
+}
+
+#endif /* STRANDBOUNDINGSPHERES_H_ */
@@ -7,11 +7,21 @@
 
 #include "VerletList.h"
 
+#include "../Utilities/ConfigInfo.h"
+
+#include <algorithm>
+
 VerletList::VerletList(std::vector<BaseParticle *> &ps, BaseBox *box) :
 				BaseList(ps, box),
 				_updated(false),
 				_cells(ps, box) {
-
+	_lees_edwards = false;
+	_shear_rate_dt = 0.;
+	_shear_factor = 0.;
+	_list_step = 0;
+	_curr_step = nullptr;
+	_incremental = false;
+	_current_stamp = 0;
 }
 
 VerletList::~VerletList() {
@@ -25,6 +35,23 @@ void VerletList::get_settings(input_file &inp) {
 	getInputNumber(&inp, "verlet_skin", &_skin, 1);
 	_sqr_skin = SQR(_skin);
 
+	getInputBool(&inp, "lees_edwards", &_lees_edwards, 0);
+	if(_lees_edwards) {
+		number shear_rate, dt;
+		getInputNumber(&inp, "lees_edwards_shear_rate", &shear_rate, 1);
+		getInputNumber(&inp, "dt", &dt, 1);
+		// this has to be multiplied by Ly, which is not known yet
+		_shear_rate_dt = shear_rate * dt;
+	}
+
+	getInputBool(&inp, "verlet_incremental", &_incremental, 0);
+	if(_incremental && !this->_is_MC) {
+		throw oxDNAException("verlet_incremental can be used only in Monte Carlo simulations");
+	}
+	if(_incremental && _lees_edwards) {
+		throw oxDNAException("verlet_incremental is incompatible with Lees-Edwards boundary conditions");
+	}
+
 	if(this->_is_MC) {
 		float delta_t = 0.f;
 		getInputFloat(&inp, "delta_translation", &delta_t, 0);
@@ -41,27 +68,169 @@ void VerletList::init(number rcut) {
 	_lists.resize(_particles.size(), std::vector<BaseParticle *>());
 	_list_poss.resize(_particles.size(), LR_vector(0, 0, 0));
 
-	_cells.init(rcut);
-	global_update();
+	this->_box_sides = this->_box->box_sides();
+	_list_inv_box = this->_box->inverse_box_matrix();
+	_curr_step = &CONFIG_INFO->curr_step;
+	// init() may be called more than once (e.g. if the cutoff changes), so the shear factor is computed from scratch
+	_shear_factor = _shear_rate_dt * this->_box->box_sides().y;
+
+	if(_incremental) {
+		_is_displaced.resize(_particles.size(), false);
+		_stamps.resize(_particles.size(), 0);
+		// a displaced particle is within rcut + 2 * skin of the list position of each of its neighbours, which can be
+		// at most a skin away from their current positions, hence the larger cells
+		_cells.init(rcut + _skin);
+	}
+	else {
+		_cells.init(rcut);
+	}
+	global_update(true);
 }
 
 bool VerletList::is_updated() {
 	return (_updated);
 }
 
+number VerletList::_sqr_max_displacement() const {
+	if(!_lees_edwards) {
+		return _sqr_skin;
+	}
+
+	// two particles that interact across the y boundary can get closer by the relative shift of the images
+	// accumulated since the last update, which is hence subtracted from the skin
+	number max_displacement = _skin - 0.5 * fabs(_shear_factor * (*_curr_step - _list_step));
+	if(max_displacement <= 0.) {
+		return -1.;
+	}
+	return SQR(max_displacement);
+}
+
+void VerletList::_check_displacement(BaseParticle *p, number sqr_max_displacement) {
+	if(_list_poss[p->index].sqr_distance(p->pos) > sqr_max_displacement) {
+		_updated = false;
+		if(_incremental && !_is_displaced[p->index]) {
+			_is_displaced[p->index] = true;
+			_displaced.push_back(p);
+		}
+	}
+}
+
 void VerletList::single_update(BaseParticle *p) {
 	_cells.single_update(p);
-	if(_list_poss[p->index].sqr_distance(p->pos) > _sqr_skin) _updated = false;
+	if(_lees_edwards) {
+		LR_vector &list_pos = _list_poss[p->index];
+		number dy = p->pos.y - list_pos.y;
+		if(fabs(dy) > 0.5 * this->_box_sides.y) {
+			// the particle has just crossed the y boundary, and its position has been shifted along x by the current
+			// offset between the images: we apply the same transformation to its list position
+			number cy = rint(dy / this->_box_sides.y);
+			list_pos.y += cy * this->_box_sides.y;
+			list_pos.x += cy * _shear_factor * *_curr_step;
+		}
+		LR_vector dr = p->pos - list_pos;
+		dr.x -= rint(dr.x / this->_box_sides.x) * this->_box_sides.x;
+		if(dr.norm() > _sqr_max_displacement()) _updated = false;
+	}
+	else {
+		_check_displacement(p, _sqr_skin);
+	}
 }
 
-void VerletList::global_update(bool force_update) {
-	if(!_cells.is_updated() || force_update) _cells.global_update();
+uint VerletList::_next_stamp() {
+	_current_stamp++;
+	if(_current_stamp == 0) {
+		std::fill(_stamps.begin(), _stamps.end(), 0);
+		_current_stamp = 1;
+	}
+	return _current_stamp;
+}
 
-	for(uint i = 0; i < _particles.size(); i++) {
-		BaseParticle *p = this->_particles[i];
-		_lists[p->index] = _cells.get_neigh_list(p);
+bool VerletList::_incremental_update() {
+	// the list positions have to be updated first, since they are used to decide whether two particles are neighbours
+	for(auto p : _displaced) {
 		_list_poss[p->index] = p->pos;
 	}
+
+	for(auto p : _displaced) {
+		std::vector<BaseParticle *> &old_list = _lists[p->index];
+		std::vector<BaseParticle *> new_list;
+		new_list.reserve(old_list.size());
+		for(auto q : _cells.get_complete_neigh_list(p)) {
+			if(this->_box->sqr_min_image_distance(_list_poss[p->index], _list_poss[q->index]) < _sqr_rcut) {
+				new_list.push_back(q);
+			}
+		}
+
+		// p gets removed from the lists of the particles that are no longer its neighbours...
+		uint stamp = _next_stamp();
+		for(auto q : new_list) {
+			_stamps[q->index] = stamp;
+		}
+		for(auto q : old_list) {
+			if(_stamps[q->index] != stamp) {
+				std::vector<BaseParticle *> &q_list = _lists[q->index];
+				auto it = std::find(q_list.begin(), q_list.end(), p);
+				// this should never happen, but if it does the lists cannot be trusted anymore
+				if(it == q_list.end()) {
+					OX_LOG(Logger::LOG_WARNING, "Particle %d is not in the Verlet list of particle %d, rebuilding all the lists", p->index, q->index);
+					return false;
+				}
+				*it = q_list.back();
+				q_list.pop_back();
+			}
+		}
+
+		// ...and added to the lists of its new neighbours
+		stamp = _next_stamp();
+		for(auto q : old_list) {
+			_stamps[q->index] = stamp;
+		}
+		for(auto q : new_list) {
+			if(_stamps[q->index] != stamp) {
+				_lists[q->index].push_back(p);
+			}
+		}
+
+		old_list.swap(new_list);
+		_is_displaced[p->index] = false;
+	}
+	_displaced.clear();
+
+	return true;
+}
+
+void VerletList::global_update(bool force_update) {
+	bool cells_updated = _cells.is_updated();
+	if(!cells_updated || force_update) _cells.global_update();
+
+	// rebuilding the lists of more than a few particles is more expensive than rebuilding everything from scratch
+	bool updated = false;
+	if(_incremental && cells_updated && !force_update && _displaced.size() < _particles.size() / 4) {
+		updated = _incremental_update();
+	}
+
+	if(!updated) {
+		for(uint i = 0; i < _particles.size(); i++) {
+			BaseParticle *p = this->_particles[i];
+			_lists[p->index] = _cells.get_neigh_list(p);
+			_list_poss[p->index] = p->pos;
+		}
+
+		if(_incremental) {
+			// the cells are larger than rcut + 2 * skin, so that the lists have to be trimmed
+			for(auto p : _particles) {
+				auto &list = _lists[p->index];
+				list.erase(std::remove_if(list.begin(), list.end(), [this, p](BaseParticle *q) {
+					return this->_box->sqr_min_image_distance(p->pos, q->pos) >= _sqr_rcut;
+				}), list.end());
+			}
+			for(auto p : _displaced) {
+				_is_displaced[p->index] = false;
+			}
+			_displaced.clear();
+		}
+	}
+	_list_step = *_curr_step;
 	_updated = true;
 }
 
@@ -73,20 +242,25 @@ std::vector<BaseParticle *> VerletList::get_complete_neigh_list(BaseParticle *p)
 	return _cells.get_complete_neigh_list(p);
 }
 
+llint VerletList::memory_footprint() {
+	llint total = _cells.memory_footprint() + (llint) _list_poss.capacity() * sizeof(LR_vector);
+	for(auto &list : _lists) {
+		total += sizeof(list) + (llint) list.capacity() * sizeof(BaseParticle *);
+	}
+	return total;
+}
+
 void VerletList::change_box() {
-	LR_vector new_box_sides = this->_box->box_sides();
-	number fx = new_box_sides.x / this->_box_sides.x;
-	number fy = new_box_sides.y / this->_box_sides.y;
-	number fz = new_box_sides.z / this->_box_sides.z;
+	// the old positions are deformed affinely, i.e. they keep their fractional coordinates
+	LR_matrix transform = this->_box->box_matrix() * _list_inv_box;
 
 	for(uint i = 0; i < _particles.size(); i++) {
 		BaseParticle *p = this->_particles[i];
-		_list_poss[p->index].x *= fx;
-		_list_poss[p->index].z *= fy;
-		_list_poss[p->index].y *= fz;
+		_list_poss[p->index] = transform * _list_poss[p->index];
 
-		if(_list_poss[p->index].sqr_distance(p->pos) > _sqr_skin) _updated = false;
+		_check_displacement(p, _sqr_skin);
 	}
+	_list_inv_box = this->_box->inverse_box_matrix();
 
 	_cells.change_box();
 	BaseList::change_box();
@@ -15,7 +15,21 @@
  *
  * @verbatim
 verlet_skin = <float> (width of the skin that controls the maximum displacement after which Verlet lists need to be updated.)
+[verlet_incremental = <bool> (Monte Carlo simulations only: if true, only the lists of the particles that have moved more than verlet_skin are rebuilt. Defaults to false)]
 @endverbatim
+ *
+ * With Lees-Edwards boundary conditions the periodic images along y slide past each other, so that the distance between
+ * particles that interact across the y boundary changes even if they do not move. Half of the relative displacement of
+ * the images accumulated since the last update is subtracted from the skin. Particles that cross the y boundary do not
+ * trigger an update, since the shift applied to their position is applied to their list position as well. This
+ * requires single_update() to be called on each particle at each time step, as done by the MD backend.
+ *
+ * In Monte Carlo simulations the lists are complete (i.e. each pair appears in the lists of both particles) and
+ * particles move one (or one cluster) at a time. With verlet_incremental = true, global_update() does not rebuild all the
+ * lists but only those of the particles that have moved beyond the skin, adding or removing them from the lists of
+ * their old and new neighbours. In this mode two particles are neighbours if their list positions are closer than
+ * rcut + 2 * skin, which is guaranteed to include all the pairs that are closer than rcut, regardless of when the two
+ * lists have been last updated.
  */
 
 class VerletList: public BaseList {
@@ -26,6 +40,44 @@ protected:
 	number _sqr_skin;
 	bool _updated;
 	number _sqr_rcut;
+	/// inverse box matrix of the box the positions in _list_poss refer to, used to map them onto a new box
+	LR_matrix _list_inv_box;
+
+	bool _lees_edwards;
+	/// shear rate * dt, as given in the input
+	number _shear_rate_dt;
+	/// shift between the periodic images along y accumulated in a time step (shear rate * Ly * dt)
+	number _shear_factor;
+	/// the step at which the lists have been last updated
+	llint _list_step;
+	/// pointer to the current step
+	const llint *_curr_step;
+
+	/**
+	 * @brief Returns the square of the maximum displacement a particle can undergo before the lists need to be updated.
+	 */
+	number _sqr_max_displacement() const;
+
+	bool _incremental;
+	/// particles that have moved beyond the skin since the last update and whose lists are to be rebuilt (incremental mode only)
+	std::vector<BaseParticle *> _displaced;
+	std::vector<bool> _is_displaced;
+	/// used to compare the old and new lists of a particle without allocating memory
+	std::vector<uint> _stamps;
+	uint _current_stamp;
+
+	/**
+	 * @brief Flags the list as outdated if p has moved beyond the skin since the last time its list was updated.
+	 */
+	void _check_displacement(BaseParticle *p, number sqr_max_displacement);
+
+	/**
+	 * @brief Rebuilds the lists of the displaced particles only, keeping the lists of the other particles consistent.
+	 *
+	 * @return false if the lists turned out not to be symmetric, in which case they should be rebuilt from scratch
+	 */
+	bool _incremental_update();
+	uint _next_stamp();
 
 	Cells _cells;
 
@@ -43,6 +95,7 @@ public:
 	virtual std::vector<BaseParticle *> get_neigh_list(BaseParticle *p);
 	virtual std::vector<BaseParticle *> get_complete_neigh_list(BaseParticle *p);
 	virtual void change_box();
+	virtual llint memory_footprint();
 };
 
 #endif /* VERLETLIST_H_ */
@@ -11,6 +11,123 @@
 #include "../PluginManagement/PluginManager.h"
 #include "../Boxes/BoxFactory.h"
 
+#include <chrono>
+#include <deque>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief A grid that stores the particles that have already been placed by the strand generator.
+ *
+ * It is never modified while the worker threads are running, so that it can be read concurrently.
+ */
+class PlacedGrid {
+public:
+	PlacedGrid(BaseBox *box, number rcut) :
+					_box(box),
+					_sqr_rcut(SQR(rcut)) {
+		_sides = box->box_sides();
+		for(int d = 0; d < 3; d++) {
+			_N_side[d] = std::max(3, (int) floor(_sides[d] / rcut));
+		}
+		_cells.resize(_N_side[0] * _N_side[1] * _N_side[2]);
+	}
+
+	void add(BaseParticle *p) {
+		int ind[3];
+		_cell_coords(p->pos, ind);
+		_cells[ind[0] + _N_side[0] * (ind[1] + _N_side[1] * ind[2])].push_back(p);
+	}
+
+	/// Returns true if pred returns true for any of the particles stored in the grid that are closer than rcut to p
+	template<typename F>
+	bool any_neighbour(BaseParticle *p, F pred) const {
+		int ind[3];
+		_cell_coords(p->pos, ind);
+		for(int i = -1; i < 2; i++) {
+			int cx = (ind[0] + i + _N_side[0]) % _N_side[0];
+			for(int j = -1; j < 2; j++) {
+				int cy = (ind[1] + j + _N_side[1]) % _N_side[1];
+				for(int k = -1; k < 2; k++) {
+					int cz = (ind[2] + k + _N_side[2]) % _N_side[2];
+					for(auto q : _cells[cx + _N_side[0] * (cy + _N_side[1] * cz)]) {
+						if(_box->sqr_min_image_distance(p->pos, q->pos) < _sqr_rcut && pred(q)) {
+							return true;
+						}
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+private:
+	BaseBox *_box;
+	number _sqr_rcut;
+	LR_vector _sides;
+	int _N_side[3];
+	std::vector<std::vector<BaseParticle *>> _cells;
+
+	void _cell_coords(const LR_vector &pos, int ind[3]) const {
+		const number rel[3] = { pos.x / _sides.x, pos.y / _sides.y, pos.z / _sides.z };
+		for(int d = 0; d < 3; d++) {
+			ind[d] = std::min((int) ((rel[d] - floor(rel[d])) * _N_side[d]), _N_side[d] - 1);
+		}
+	}
+};
+
+/// The coordinates of the particles of a strand, relative to the strand's centre, and their orientations
+struct StrandTemplate {
+	std::vector<LR_vector> positions;
+	std::vector<LR_matrix> orientations;
+	number extent = 0.;
+};
+
+struct StrandPlacement {
+	LR_matrix rotation;
+	LR_vector centre;
+};
+
+/**
+ * @brief Returns the particles of the given strand sorted along the chain, from the 3' to the 5' end.
+ *
+ * Particles that are not connected through their n3/n5 pointers are returned in index order.
+ */
+std::vector<BaseParticle *> sort_strand(const std::vector<BaseParticle *> &strand) {
+	BaseParticle *start = strand[0];
+	for(auto p : strand) {
+		if(p->n3 == P_VIRTUAL || p->n3->strand_id != p->strand_id) {
+			start = p;
+			break;
+		}
+	}
+
+	std::vector<BaseParticle *> sorted;
+	BaseParticle *curr = start;
+	do {
+		sorted.push_back(curr);
+		curr = curr->n5;
+	} while(curr != P_VIRTUAL && curr != start && curr->strand_id == start->strand_id && sorted.size() < strand.size());
+
+	if(sorted.size() != strand.size()) {
+		return strand;
+	}
+	return sorted;
+}
+
+void place_strand(const std::vector<BaseParticle *> &strand, const StrandTemplate &templ, const StrandPlacement &placement) {
+	for(uint i = 0; i < strand.size(); i++) {
+		BaseParticle *p = strand[i];
+		p->pos = placement.centre + placement.rotation * templ.positions[i];
+		p->orientation = placement.rotation * templ.orientations[i];
+		p->orientationT = p->orientation.get_transpose();
+		p->set_positions();
+	}
+}
+
+}
+
 GeneratorManager::GeneratorManager(input_file input, char *third_argument) :
 				_input(input) {
 	_use_density = false;
@@ -58,6 +175,13 @@ GeneratorManager::GeneratorManager(input_file input, char *third_argument) :
 	_external_forces = false;
 	_external_filename = std::string("");
 
+	_mode = "random";
+	_time_budget = 0.;
+	_N_threads = 1;
+	_helix_rise = 0.3897628551303122;
+	_helix_twist = 0.6266;
+	_helix_radius = 0.6;
+
 	ConfigInfo::init(&_particles, &_molecules);
 }
 
@@ -101,6 +225,21 @@ void GeneratorManager::load_options() {
 	_interaction->get_settings(_input);
 
 	getInputBool(&_input, "external_forces", &_external_forces, 0);
+
+	getInputString(&_input, "generator_mode", _mode, 0);
+	if(_mode != "random" && _mode != "lattice" && _mode != "strands") {
+		throw oxDNAException("Unsupported generator_mode '%s' (should be 'random', 'lattice' or 'strands')", _mode.c_str());
+	}
+	getInputDouble(&_input, "generator_time_budget", &_time_budget, 0);
+	_interaction->set_generate_time_budget(_time_budget);
+
+	getInputInt(&_input, "generator_threads", &_N_threads, 0);
+	if(_N_threads < 1) {
+		throw oxDNAException("generator_threads should be a positive integer");
+	}
+	getInputNumber(&_input, "generator_helix_rise", &_helix_rise, 0);
+	getInputNumber(&_input, "generator_helix_twist", &_helix_twist, 0);
+	getInputNumber(&_input, "generator_helix_radius", &_helix_radius, 0);
 }
 
 void GeneratorManager::init() {
@@ -112,7 +251,10 @@ void GeneratorManager::init() {
 	_interaction->read_topology(&N_strands, _particles);
 
 	// initialise the molecules
-	_molecules.resize(N_strands, std::make_shared<Molecule>());
+	Molecule::reset_id();
+	for(int i = 0; i < N_strands; i++) {
+		_molecules.push_back(std::make_shared<Molecule>());
+	}
 	for(auto p : _particles) {
 		int mol_id = p->strand_id;
 		_molecules[mol_id]->add_particle(p);
@@ -139,8 +281,295 @@ void GeneratorManager::init() {
 	ForceFactory::instance()->make_forces(_particles, _mybox.get());
 }
 
+void GeneratorManager::_generate_lattice() {
+	for(auto p : _particles) {
+		if(p->affected.size() > 0) {
+			throw oxDNAException("generator_mode = lattice cannot be used with systems containing bonded interactions");
+		}
+	}
+
+	// we look for the smallest fcc lattice (4 sites per unit cell) that has enough sites and fits the box
+	LR_vector sides = _mybox->box_sides();
+	number cell_side = cbrt(4. * sides.x * sides.y * sides.z / _N);
+	int cells[3];
+	do {
+		for(int d = 0; d < 3; d++) {
+			cells[d] = std::max(1, (int) floor(sides[d] / cell_side));
+		}
+		cell_side *= 0.99;
+	} while(4 * cells[0] * cells[1] * cells[2] < _N);
+	OX_LOG(Logger::LOG_INFO, "Putting %d particles on a %d x %d x %d fcc lattice", _N, cells[0], cells[1], cells[2]);
+
+	const number offsets[4][3] = { {0., 0., 0.}, {0.5, 0.5, 0.}, {0.5, 0., 0.5}, {0., 0.5, 0.5} };
+	std::vector<LR_vector> sites;
+	sites.reserve(4 * cells[0] * cells[1] * cells[2]);
+	for(int i = 0; i < cells[0]; i++) {
+		for(int j = 0; j < cells[1]; j++) {
+			for(int k = 0; k < cells[2]; k++) {
+				for(int s = 0; s < 4; s++) {
+					sites.push_back(LR_vector((i + offsets[s][0]) * sides.x / cells[0], (j + offsets[s][1]) * sides.y / cells[1], (k + offsets[s][2]) * sides.z / cells[2]));
+				}
+			}
+		}
+	}
+
+	// the empty sites are randomly distributed
+	for(int i = sites.size() - 1; i > 0; i--) {
+		int j = (int) (drand48() * (i + 1));
+		std::swap(sites[i], sites[j]);
+	}
+
+	for(int i = 0; i < _N; i++) {
+		BaseParticle *p = _particles[i];
+		p->pos = sites[i];
+		p->orientation = Utils::get_random_rotation_matrix_from_angle(acos(2. * (drand48() - 0.5)));
+		p->orientation.orthonormalize();
+		p->orientationT = p->orientation.get_transpose();
+		p->set_positions();
+
+		if(_N > 10 && i > 0 && i % (_N / 10) == 0) {
+			OX_LOG(Logger::LOG_INFO, "Placed %d%% of the particles (%d/%d)", i * 100 / _N, i, _N);
+		}
+	}
+
+	// the lattice may be too dense for the particles, in which case we let the user know
+	Cells c(_particles, _mybox.get());
+	c.init(_interaction->get_rcut());
+	c.global_update();
+	int overlapping = 0;
+	for(auto p : _particles) {
+		for(auto q : c.get_complete_neigh_list(p)) {
+			if(_interaction->generate_random_configuration_overlap(p, q)) {
+				overlapping++;
+				break;
+			}
+		}
+	}
+	if(overlapping > 0) {
+		OX_LOG(Logger::LOG_WARNING, "%d particles of the lattice configuration overlap with at least another particle: the configuration should be relaxed before it can be used", overlapping);
+	}
+}
+
+void GeneratorManager::_generate_strands() {
+	const int attempts_per_round = 100;
+
+	std::map<int, std::vector<BaseParticle *>> strand_map;
+	for(auto p : _particles) {
+		strand_map[p->strand_id].push_back(p);
+	}
+
+	std::vector<std::vector<BaseParticle *>> strands;
+	for(auto &entry : strand_map) {
+		for(auto p : entry.second) {
+			for(auto &pair : p->affected) {
+				if(pair.first->strand_id != p->strand_id || pair.second->strand_id != p->strand_id) {
+					throw oxDNAException("generator_mode = strands cannot be used with systems containing bonds between different strands (particle %d)", p->index);
+				}
+			}
+		}
+		strands.push_back(sort_strand(entry.second));
+	}
+
+	// strands of the same length share the same template, which is an ideal helix
+	std::map<int, StrandTemplate> templates;
+	for(auto &strand : strands) {
+		int length = strand.size();
+		if(templates.count(length) > 0) {
+			continue;
+		}
+		StrandTemplate &templ = templates[length];
+		LR_vector centre;
+		for(int i = 0; i < length; i++) {
+			LR_vector a1(cos(i * _helix_twist), sin(i * _helix_twist), 0.);
+			LR_vector a3(0., 0., 1.);
+			templ.positions.push_back(LR_vector(0., 0., i * _helix_rise) - a1 * _helix_radius);
+			templ.orientations.push_back(LR_matrix(a1, a3.cross(a1), a3).get_transpose());
+			centre += templ.positions.back();
+		}
+		centre /= length;
+		for(auto &pos : templ.positions) {
+			pos -= centre;
+			templ.extent = std::max(templ.extent, pos.module());
+		}
+	}
+
+	number energy_threshold = 100.;
+	getInputNumber(&_input, "energy_threshold", &energy_threshold, 0);
+
+	// we check that the template does not stretch the bonds too much
+	LR_vector box_centre = _mybox->box_sides() / 2.;
+	for(auto &strand : strands) {
+		place_strand(strand, templates[strand.size()], StrandPlacement { LR_matrix(1., 0., 0., 0., 1., 0., 0., 0., 1.), box_centre });
+		for(auto p : strand) {
+			for(auto &pair : p->affected) {
+				if(pair.first == p) {
+					number e = _interaction->pair_interaction_bonded(pair.first, pair.second);
+					if(std::isnan(e) || e > energy_threshold) {
+						throw oxDNAException("The bonded energy between particles %d and %d in the helix built by the strand generator is too high (%lf): try changing generator_helix_rise, generator_helix_twist or generator_helix_radius", pair.first->index, pair.second->index, e);
+					}
+				}
+			}
+		}
+	}
+
+	// each worker thread needs its own interaction, since interactions store the state of the last computation.
+	// Some interactions also store per-particle information built from the topology, and hence each clone reads the
+	// topology too. The particles it allocates are kept until the function returns (or throws), since they may be
+	// referred to. The clones are destroyed first, and unsubscribe from the ConfigInfo events in their destructors
+	struct CloneParticles {
+		std::vector<std::vector<BaseParticle *>> particles;
+		~CloneParticles() {
+			for(auto &ps : particles) {
+				for(auto p : ps) {
+					delete p;
+				}
+			}
+		}
+	} clone_particles;
+	std::vector<InteractionPtr> interactions(1, _interaction);
+	for(int t = 1; t < _N_threads; t++) {
+		InteractionPtr clone = InteractionFactory::make_interaction(_input);
+		clone->get_settings(_input);
+		clone->init();
+		clone_particles.particles.emplace_back(_N);
+		int clone_N_strands;
+		clone->read_topology(&clone_N_strands, clone_particles.particles.back());
+		clone->set_box(_mybox.get());
+		interactions.push_back(clone);
+	}
+
+	number rcut = _interaction->get_rcut();
+	number sqr_rcut = SQR(rcut);
+	number min_side = std::min(std::min(_box_side_x, _box_side_y), _box_side_z);
+	PlacedGrid grid(_mybox.get(), rcut);
+	// the round in which each particle has been placed, or -1 if it has not been placed yet
+	std::vector<int> placed_round(_N, -1);
+
+	std::string raw_T;
+	getInputString(&_input, "T", raw_T, 1);
+	number T = Utils::get_temperature(raw_T);
+
+	// worker threads try to place their strand without overlapping with the strands placed in the previous rounds
+	auto try_to_place = [&](int t, std::vector<BaseParticle *> &strand, const std::vector<StrandPlacement> &placements, int &accepted) {
+		BaseInteraction *interaction = interactions[t].get();
+		const StrandTemplate &templ = templates.at(strand.size());
+		// strands that are longer than half the box may overlap with their own periodic images
+		bool check_self = 2. * templ.extent > min_side / 2.;
+		auto overlap = [interaction](BaseParticle *p, BaseParticle *q) {
+			return interaction->generate_random_configuration_overlap(p, q);
+		};
+
+		accepted = -1;
+		for(uint a = 0; a < placements.size() && accepted == -1; a++) {
+			place_strand(strand, templ, placements[a]);
+			bool overlapping = false;
+			for(uint i = 0; i < strand.size() && !overlapping; i++) {
+				BaseParticle *p = strand[i];
+				overlapping = grid.any_neighbour(p, [p, &overlap](BaseParticle *q) {
+					return overlap(p, q);
+				});
+				for(uint j = i + 2; check_self && j < strand.size() && !overlapping; j++) {
+					BaseParticle *q = strand[j];
+					overlapping = !p->is_bonded(q) && _mybox->sqr_min_image_distance(p->pos, q->pos) < sqr_rcut && overlap(p, q);
+				}
+			}
+			if(!overlapping) {
+				accepted = a;
+			}
+		}
+	};
+
+	std::deque<int> to_place;
+	for(uint s = 0; s < strands.size(); s++) {
+		to_place.push_back(s);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	auto elapsed = [&start]() {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	};
+
+	int N_strands = strands.size();
+	int N_placed = 0;
+	int next_report = 1;
+	for(int round = 0; to_place.size() > 0; round++) {
+		if(_time_budget > 0. && elapsed() > _time_budget) {
+			throw oxDNAException("The generation of the initial configuration exceeded the time budget of %g seconds after inserting %d strands out of %d. Try with a lower density", _time_budget, N_placed, N_strands);
+		}
+
+		// the random numbers are all drawn here, so that the worker threads do not share the state of the generator
+		int N_workers = std::min((int) to_place.size(), _N_threads);
+		std::vector<int> round_strands(N_workers);
+		std::vector<std::vector<StrandPlacement>> placements(N_workers);
+		for(int t = 0; t < N_workers; t++) {
+			round_strands[t] = to_place.front();
+			to_place.pop_front();
+			for(int a = 0; a < attempts_per_round; a++) {
+				LR_matrix rotation = Utils::get_random_rotation_matrix_from_angle(acos(2. * (drand48() - 0.5)));
+				rotation.orthonormalize();
+				LR_vector centre(drand48() * _box_side_x, drand48() * _box_side_y, drand48() * _box_side_z);
+				placements[t].push_back(StrandPlacement { rotation, centre });
+			}
+		}
+
+		std::vector<int> accepted(N_workers);
+		std::vector<std::thread> threads;
+		for(int t = 1; t < N_workers; t++) {
+			threads.emplace_back(try_to_place, t, std::ref(strands[round_strands[t]]), std::cref(placements[t]), std::ref(accepted[t]));
+		}
+		try_to_place(0, strands[round_strands[0]], placements[0], accepted[0]);
+		for(auto &thread : threads) {
+			thread.join();
+		}
+
+		// strands placed during the same round may overlap with each other, and they should also satisfy the external potential
+		for(int t = 0; t < N_workers; t++) {
+			int s = round_strands[t];
+			std::vector<BaseParticle *> &strand = strands[s];
+			bool inserted = accepted[t] != -1;
+
+			number ext_potential = 0.;
+			for(uint i = 0; i < strand.size() && inserted; i++) {
+				BaseParticle *p = strand[i];
+				inserted = !grid.any_neighbour(p, [this, p, &placed_round, round](BaseParticle *q) {
+					return placed_round[q->index] == round && _interaction->generate_random_configuration_overlap(p, q);
+				});
+				p->set_ext_potential(0, _mybox.get());
+				ext_potential += p->ext_potential;
+			}
+			if(inserted && (std::isnan(ext_potential) || drand48() > exp(-ext_potential / T))) {
+				inserted = false;
+			}
+
+			if(inserted) {
+				for(auto p : strand) {
+					grid.add(p);
+					placed_round[p->index] = round;
+				}
+				N_placed++;
+			}
+			else {
+				to_place.push_back(s);
+			}
+		}
+
+		if(N_strands >= 10 && N_placed >= next_report * N_strands / 10) {
+			OX_LOG(Logger::LOG_INFO, "Inserted %d%% of the strands (%d/%d) in %.1lf seconds", N_placed * 100 / N_strands, N_placed, N_strands, elapsed());
+			next_report = N_placed * 10 / N_strands + 1;
+		}
+	}
+}
+
 void GeneratorManager::generate() {
-	_interaction->generate_random_configuration(_particles);
+	if(_mode == "lattice") {
+		_generate_lattice();
+	}
+	else if(_mode == "strands") {
+		_generate_strands();
+	}
+	else {
+		_interaction->generate_random_configuration(_particles);
+	}
 
 	ofstream conf_output(_output_conf);
 	conf_output.precision(15);
@@ -15,6 +15,15 @@
 
 /**
  * @brief Manages the generation of an initial configuration.
+ *
+ * @verbatim
+[generator_mode = random|lattice|strands (random inserts the particles one by one at random positions, rejecting the insertions that result in overlaps. lattice puts the particles on the sites of an fcc lattice that fills the box, which is much faster at high densities but it is available only if there are no bonded interactions. strands inserts whole strands at once as rigid ideal helices, which is much faster for systems made of many DNA or RNA strands. Defaults to random)]
+[generator_time_budget = <float> (maximum time, in seconds, that the generation is allowed to take before giving up. Defaults to 0, which means no limit)]
+[generator_threads = <int> (number of threads used to insert strands concurrently when generator_mode = strands. Defaults to 1)]
+[generator_helix_rise = <float> (distance between consecutive nucleotides along the axis of the helices built when generator_mode = strands. Defaults to 0.3897628551303122)]
+[generator_helix_twist = <float> (angle, in radians, between consecutive nucleotides of the helices built when generator_mode = strands. Defaults to 0.6266)]
+[generator_helix_radius = <float> (distance between the centres of mass of the nucleotides and the axis of the helices built when generator_mode = strands. Defaults to 0.6)]
+@endverbatim
  */
 class GeneratorManager {
 protected:
@@ -37,6 +46,14 @@ protected:
 
 	std::shared_ptr<BaseBox> _mybox;
 
+	std::string _mode;
+	double _time_budget;
+	int _N_threads;
+	number _helix_rise, _helix_twist, _helix_radius;
+
+	void _generate_lattice();
+	void _generate_strands();
+
 public:
 	GeneratorManager(input_file input, char *third_argument);
 	virtual ~GeneratorManager();
@@ -34,6 +34,9 @@ SimManager::SimManager(input_file input) :
 	_backend = nullptr;
 	_fix_diffusion_every = 100000;
 	_time_scale = -1;
+	_metrics = std::make_shared<MetricsExporter>();
+	_metrics_last_step = 0;
+	_annealing = std::make_shared<AnnealingSchedule>();
 }
 
 SimManager::~SimManager() {
@@ -49,6 +52,9 @@ SimManager::~SimManager() {
 
 	cleanTimeScale(&_time_scale_manager);
 
+	// the exporting thread should be stopped before the backend goes away
+	_metrics->stop();
+
 	if(_backend != nullptr) {
 		int updated = _backend->get_N_updates();
 		if(updated > 0) {
@@ -89,6 +95,9 @@ void SimManager::load_options() {
 	}
 
 	getInputInt(&_input, "fix_diffusion_every", &_fix_diffusion_every, 0);
+
+	_metrics->get_settings(_input);
+	_annealing->get_settings(_input);
 }
 
 void SimManager::init() {
@@ -120,6 +129,7 @@ void SimManager::init() {
 	else throw oxDNAException("Time scale '%s' not supported", ts_type);
 
 	_backend->init();
+	_backend->print_memory_usage();
 
 	// init time_scale_manager
 	initTimeScale(&_time_scale_manager, _time_scale);
@@ -136,6 +146,37 @@ void SimManager::init() {
 	// trajectory files...
 	setTSInitialStep(&_time_scale_manager, _backend->start_step_from_file + tmpm - (_backend->start_step_from_file % tmpm));
 	// end
+
+	_metrics->init();
+	_metrics_last_time = std::chrono::steady_clock::now();
+	_metrics_last_step = _backend->current_step();
+
+	if(_annealing->enabled()) {
+		_anneal();
+	}
+}
+
+void SimManager::_update_metrics() {
+	auto now = std::chrono::steady_clock::now();
+	double elapsed = std::chrono::duration<double>(now - _metrics_last_time).count();
+	llint curr_step = _backend->current_step();
+
+	std::vector<MetricsExporter::metric> metrics;
+	_backend->get_metrics(metrics);
+	if(elapsed > 0.) {
+		metrics.emplace_back("oxdna_steps_per_second", (curr_step - _metrics_last_step) / elapsed);
+	}
+	_metrics->publish(metrics);
+
+	_metrics_last_time = now;
+	_metrics_last_step = curr_step;
+}
+
+void SimManager::_anneal() {
+	number new_T = _annealing->temperature(_backend->current_step());
+	if(new_T != CONFIG_INFO->temperature()) {
+		CONFIG_INFO->update_temperature(new_T);
+	}
 }
 
 void SimManager::run() {
@@ -147,6 +188,7 @@ void SimManager::run() {
 		OX_LOG(Logger::LOG_INFO, "Equilibrating...");
 		for(llint step = 0; step < _equilibration_steps && !SimManager::stop; step++) {
 			_backend->sim_step();
+			CONFIG_INFO->flush_events();
 			if (step > 1 && step % _fix_diffusion_every == 0) _backend->fix_diffusion();
 		}
 		OX_LOG(Logger::LOG_INFO, "Equilibration done");
@@ -168,7 +210,14 @@ void SimManager::run() {
 
 		_backend->update_observables_data();
 		_backend->print_observables();
+		if(_metrics->is_due(_backend->current_step())) {
+			_update_metrics();
+		}
+		if(_annealing->is_due(_backend->current_step())) {
+			_anneal();
+		}
 		_backend->sim_step();
+		CONFIG_INFO->flush_events();
 		_backend->increment_current_step();
 	}
 	// this is in case _cur_step, after being increased by 1 before exiting the loop,
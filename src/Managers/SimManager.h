@@ -11,10 +11,13 @@
 
 #include <cstring>
 #include <ctime>
+#include <chrono>
 
 #include "../defs.h"
 #include "../Backends/SimBackend.h"
 #include "../Utilities/time_scales/time_scales.h"
+#include "../Utilities/MetricsExporter.h"
+#include "../Utilities/AnnealingSchedule.h"
 
 struct double4;
 struct float4;
@@ -50,6 +53,19 @@ protected:
 	int _print_input;
 	int _fix_diffusion_every;
 
+	std::shared_ptr<MetricsExporter> _metrics;
+	std::chrono::steady_clock::time_point _metrics_last_time;
+	llint _metrics_last_step;
+
+	void _update_metrics();
+
+	std::shared_ptr<AnnealingSchedule> _annealing;
+
+	/**
+	 * @brief Sets the temperature to the value prescribed by the annealing schedule for the current step, if it differs from the current one.
+	 */
+	void _anneal();
+
 public:
 	SimManager(input_file input);
 	virtual ~SimManager();
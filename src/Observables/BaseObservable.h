@@ -68,6 +68,15 @@ public:
 	 */
 	virtual void init();
 
+	/**
+	 * @brief Returns an estimate of the memory used by the observable's internal data structures (e.g. histograms), in bytes.
+	 *
+	 * The default implementation returns 0.
+	 */
+	virtual llint memory_footprint() {
+		return 0;
+	}
+
 	void set_id(std::string id) {
 		_id = id;
 	}
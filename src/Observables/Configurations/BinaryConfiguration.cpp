@@ -19,6 +19,10 @@ BinaryConfiguration::~BinaryConfiguration() {
 }
 
 std::string BinaryConfiguration::_headers(llint step) {
+	if(_config_info->box->geometry() == BaseBox::TRICLINIC) {
+		throw oxDNAException("Binary configurations do not support triclinic boxes");
+	}
+
 	std::stringstream headers;
 
 	headers.write((char *) (&step), sizeof(llint));
@@ -11,6 +11,7 @@
 
 #include "Configuration.h"
 #include "../../Particles/BaseParticle.h"
+#include "../../Particles/Molecule.h"
 
 using namespace std;
 
@@ -99,7 +100,13 @@ string Configuration::_headers(llint step) {
 		number K = _tot_energy.get_K(step);
 
 		headers << "t = " << step << endl;
-		headers << "b = " << _config_info->box->box_sides().x << " " << _config_info->box->box_sides().y << " " << _config_info->box->box_sides().z << endl;
+		headers << "b = " << _config_info->box->box_sides().x << " " << _config_info->box->box_sides().y << " " << _config_info->box->box_sides().z;
+		if(_config_info->box->geometry() == BaseBox::TRICLINIC) {
+			// the tilt factors xy, xz and yz are the off-diagonal elements of the box matrix
+			LR_matrix H = _config_info->box->box_matrix();
+			headers << " " << H.v1.y << " " << H.v1.z << " " << H.v2.z;
+		}
+		headers << endl;
 		headers << "E = " << U + K << " " << U << " " << K << endl;
 	}
 
@@ -113,7 +120,12 @@ string Configuration::_particle(BaseParticle *p) {
 	LR_vector box_sides = _config_info->box->box_sides();
 
 	LR_vector mypos;
-	if(_back_in_box) {
+	if(_back_in_box && _config_info->box->geometry() == BaseBox::TRICLINIC) {
+		// shift the particle by the lattice vectors that bring its strand's centre of mass back in the box
+		LR_vector s = _config_info->box->inverse_box_matrix() * _strands_cdm[p->strand_id];
+		mypos = p->pos - _config_info->box->box_matrix() * LR_vector(floor(s.x), floor(s.y), floor(s.z));
+	}
+	else if(_back_in_box) {
 		mypos.x = p->pos.x - floor(_strands_cdm[p->strand_id].x / box_sides.x) * box_sides.x;
 		mypos.y = p->pos.y - floor(_strands_cdm[p->strand_id].y / box_sides.y) * box_sides.y;
 		mypos.z = p->pos.z - floor(_strands_cdm[p->strand_id].z / box_sides.z) * box_sides.z;
@@ -186,6 +198,19 @@ string Configuration::get_output_string(llint curr_step) {
 void Configuration::_fill_strands_cdm() {
 	std::map<int, int> nin;
 	_strands_cdm.clear();
+
+	// if all the particles are visible we can use the centres of mass cached by the molecules
+	auto &molecules = _config_info->molecules();
+	if(_visible_particles.size() == _config_info->particles().size() && molecules.size() > 0) {
+		for(auto mol : molecules) {
+			if(mol->N() > 0) {
+				mol->update_properties();
+				_strands_cdm[mol->particles[0]->strand_id] = mol->com;
+			}
+		}
+		return;
+	}
+
 	for(auto p_idx : _visible_particles) {
 		BaseParticle *p = _config_info->particles()[p_idx];
 		if(_strands_cdm.count(p->strand_id) == 0) {
@@ -123,3 +123,7 @@ void DensityProfile::get_settings(input_file &my_inp, input_file &sim_inp) {
 
 	_profile.resize(_nbins);
 }
+
+llint DensityProfile::memory_footprint() {
+	return (llint) _profile.capacity() * sizeof(long int);
+}
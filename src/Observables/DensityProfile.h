@@ -57,6 +57,8 @@ public:
 
 	virtual std::string get_output_string(llint curr_step);
 	void get_settings(input_file &my_inp, input_file &sim_inp);
+
+	llint memory_footprint() override;
 };
 
 #endif /* DENSITY_H_ */
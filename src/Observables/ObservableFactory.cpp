@@ -11,6 +11,7 @@
 
 #include "Step.h"
 #include "PotentialEnergy.h"
+#include "ParameterDerivatives.h"
 #include "KineticEnergy.h"
 #include "TotalEnergy.h"
 #include "Configurations/Configuration.h"
@@ -71,6 +72,7 @@ ObservablePtr ObservableFactory::make_observable(input_file &obs_inp) {
 
 	if(!strncasecmp(obs_type, "step", 512)) res = std::make_shared<Step>();
 	else if(!strncasecmp(obs_type, "potential_energy", 512)) res = std::make_shared<PotentialEnergy>();
+	else if(!strncasecmp(obs_type, "parameter_derivatives", 512)) res = std::make_shared<ParameterDerivatives>();
 	else if(!strncasecmp(obs_type, "kinetic_energy", 512)) res = std::make_shared<KineticEnergy>();
 	else if(!strncasecmp(obs_type, "total_energy", 512)) res = std::make_shared<TotalEnergy>();
 	else if(!strncasecmp(obs_type, "backend_info", 512)) res = std::make_shared<BackendInfo>();
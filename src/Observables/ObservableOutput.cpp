@@ -175,6 +175,33 @@ bool ObservableOutput::is_ready(llint step) {
 	}
 }
 
+llint ObservableOutput::next_ready_step(llint step) {
+	if(_stop_at > -1 && step > _stop_at) {
+		return -1;
+	}
+
+	llint next;
+	if(_linear) {
+		if(_print_every < 1) return -1;
+		next = std::max(step, _start_from);
+		if(next % _print_every != 0) {
+			next += _print_every - (next % _print_every);
+		}
+	}
+	else {
+		while(_log_next < step) {
+			_set_next_log_step();
+		}
+		next = _log_next;
+	}
+
+	if(_stop_at > -1 && next > _stop_at) {
+		return -1;
+	}
+
+	return next;
+}
+
 void ObservableOutput::print_output(llint step) {
 	stringstream ss;
 	for(auto it = _obss.begin(); it != _obss.end(); it++) {
@@ -207,3 +234,12 @@ void ObservableOutput::print_output(llint step) {
 		_set_next_log_step();
 	}
 }
+
+llint ObservableOutput::memory_footprint() {
+	llint footprint = sizeof(ObservableOutput) + (llint) _obss.capacity() * sizeof(ObservablePtr);
+	for(auto obs : _obss) {
+		footprint += obs->memory_footprint();
+	}
+
+	return footprint;
+}
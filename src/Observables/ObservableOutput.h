@@ -127,6 +127,14 @@ public:
 	 */
 	bool is_ready(llint step);
 
+	/**
+	 * @brief Returns the first step, equal to or larger than the given one, at which the object will be ready to print
+	 *
+	 * @param step simulation step
+	 * @return the next step at which is_ready() will return true, or -1 if the object will never be ready again
+	 */
+	llint next_ready_step(llint step);
+
 	/**
 	 * @brief Returns the number of bytes written to the output file
 	 *
@@ -142,6 +150,11 @@ public:
 	std::string get_output_name() {
 		return _output_name;
 	}
+
+	/**
+	 * @brief Returns an estimate of the memory used by the observables managed by this object, in bytes
+	 */
+	llint memory_footprint();
 };
 
 using ObservableOutputPtr = std::shared_ptr<ObservableOutput>;
@@ -0,0 +1,43 @@
+/*
+ * ParameterDerivatives.cpp
+ */
+
+#include "ParameterDerivatives.h"
+
+ParameterDerivatives::ParameterDerivatives() {
+
+}
+
+ParameterDerivatives::~ParameterDerivatives() {
+
+}
+
+void ParameterDerivatives::init() {
+	BaseObservable::init();
+
+	auto &derivatives = _config_info->interaction->get_parameter_derivatives();
+	if(derivatives.size() == 0) {
+		throw oxDNAException("The parameter_derivatives observable requires an interaction that supports the computation of the derivatives of the energy (DNA2 or RNA2) and compute_parameter_derivatives = true");
+	}
+
+	std::string names;
+	for(auto &derivative : derivatives) {
+		names += " " + derivative.first;
+	}
+	OX_LOG(Logger::LOG_INFO, "The parameter_derivatives observable will print the derivatives of the energy with respect to:%s", names.c_str());
+}
+
+std::string ParameterDerivatives::get_output_string(llint curr_step) {
+	// the derivatives are accumulated during the sweep, so the energy has to be computed from scratch
+	_config_info->interaction->get_system_energy(_config_info->particles(), _config_info->lists);
+
+	std::string res;
+	for(auto &derivative : _config_info->interaction->get_parameter_derivatives()) {
+		if(res.size() > 0) {
+			res += " ";
+		}
+		res += Utils::sformat(_number_formatter, derivative.second);
+	}
+
+	return res;
+}
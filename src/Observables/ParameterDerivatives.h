@@ -0,0 +1,30 @@
+/*
+ * ParameterDerivatives.h
+ */
+
+#ifndef PARAMETERDERIVATIVES_H_
+#define PARAMETERDERIVATIVES_H_
+
+#include "BaseObservable.h"
+
+/**
+ * @brief Outputs the derivatives of the total potential energy with respect to the parameters of the model.
+ *
+ * The derivatives are accumulated by the interaction during a single sweep over all the interacting pairs, which
+ * makes it possible to reweight configurations when fitting the parameters without re-evaluating the energy once per
+ * parameter. This is supported by the DNA2 and RNA2 interactions only, and requires compute_parameter_derivatives = true
+ * in the main input file. The values are printed in the alphabetical order of the names of the parameters, which are
+ * reported in the log when the observable is initialised.
+ */
+
+class ParameterDerivatives: public BaseObservable {
+public:
+	ParameterDerivatives();
+	virtual ~ParameterDerivatives();
+
+	void init() override;
+
+	std::string get_output_string(llint curr_step) override;
+};
+
+#endif /* PARAMETERDERIVATIVES_H_ */
@@ -18,7 +18,7 @@ PotentialEnergy::~PotentialEnergy() {
 
 number PotentialEnergy::get_potential_energy() {
 	_config_info->interaction->set_is_infinite(false);
-	number energy = _config_info->interaction->get_system_energy(_config_info->particles(), _config_info->lists);
+	number energy = _config_info->system_energy();
 	energy /= _config_info->N();
 
 	if(_config_info->interaction->get_is_infinite()) {
@@ -42,7 +42,7 @@ std::string PotentialEnergy::get_output_string(llint curr_step) {
 	}
 	else {
 		std::string res("");
-		auto energies = _config_info->interaction->get_system_energy_split(_config_info->particles(), _config_info->lists);
+		auto energies = _config_info->system_energy_split();
 		for(auto energy_item : energies) {
 			number contrib = energy_item.second / _config_info->N();
 			res = Utils::sformat("%s " + _number_formatter, res.c_str(), contrib);
@@ -98,3 +98,7 @@ void Rdf::get_settings(input_file &my_inp, input_file &sim_inp) {
 
 	_profile.resize(_nbins);
 }
+
+llint Rdf::memory_footprint() {
+	return (llint) _profile.capacity() * sizeof(long double);
+}
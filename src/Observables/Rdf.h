@@ -62,6 +62,8 @@ public:
 	std::string get_output_string(llint curr_step) override;
 
 	void get_settings(input_file &my_inp, input_file &sim_inp);
+
+	llint memory_footprint() override;
 };
 
 #endif /* RDF_H_ */
@@ -161,3 +161,14 @@ std::string StressAutocorrelation::get_output_string(llint curr_step) {
 
 	return ss.str();
 }
+
+llint StressAutocorrelation::memory_footprint() {
+	llint footprint = (llint) (_old_forces.capacity() + _old_torques.capacity()) * sizeof(LR_vector);
+	for(auto level : {_sigma_xy, _sigma_yz, _sigma_xz, _N_xy, _N_yz, _N_xz, _sigma_xx, _sigma_yy, _sigma_zz, _sigma_P}) {
+		if(level != nullptr) {
+			footprint += level->memory_footprint();
+		}
+	}
+
+	return footprint;
+}
@@ -101,6 +101,15 @@ class StressAutocorrelation: public BaseObservable {
 			}
 		}
 
+		/// returns the memory used by this level and by all the levels that come after it
+		llint memory_footprint() const {
+			llint footprint = sizeof(Level) + (llint) (data.capacity() + correlation.capacity()) * sizeof(double) + (llint) counter.capacity() * sizeof(uint);
+			if(next != nullptr) {
+				footprint += next->memory_footprint();
+			}
+			return footprint;
+		}
+
 		void get_times(double dt, std::vector<double>& times) {
 			for(uint i = start_at; i < p; i++) {
 				if(counter[i] > 0) {
@@ -191,6 +200,8 @@ public:
 	void update_data(llint curr_step) override;
 
 	std::string get_output_string(llint curr_step);
+
+	llint memory_footprint() override;
 };
 
 #endif /* STRESSAUTOCORRELATION_H_ */
@@ -142,3 +142,11 @@ std::string StructureFactor::get_output_string(llint curr_step) {
 
 	return ret.str();
 }
+
+llint StructureFactor::memory_footprint() {
+	llint footprint = (llint) (_sq.capacity() + _sq_cos.capacity() + _sq_sin.capacity()) * sizeof(long double);
+	// each node of a std::list also stores two pointers
+	footprint += (llint) _qs.size() * (sizeof(LR_vector) + 2 * sizeof(void *));
+
+	return footprint;
+}
@@ -59,6 +59,8 @@ public:
 	void update_data(llint curr_step) override;
 
 	std::string get_output_string(llint curr_step) override;
+
+	llint memory_footprint() override;
 };
 
 #endif /* STRUCTUREFACTOR_H_ */
@@ -7,6 +7,7 @@
 
 #include "BaseParticle.h"
 
+#include "ParticleArena.h"
 #include "../Boxes/BaseBox.h"
 
 BaseParticle::BaseParticle() :
@@ -56,12 +57,38 @@ BaseParticle::~BaseParticle() {
 
 }
 
+void *BaseParticle::operator new(std::size_t size) {
+	return ParticleArena::instance().allocate(size);
+}
+
+void BaseParticle::operator delete(void *ptr) {
+	ParticleArena::instance().deallocate(ptr);
+}
+
+void *BaseParticle::operator new[](std::size_t size) {
+	return ParticleArena::instance().allocate(size);
+}
+
+void BaseParticle::operator delete[](void *ptr) {
+	ParticleArena::instance().deallocate(ptr);
+}
+
 bool BaseParticle::add_ext_force(BaseForce *f) {
 	ext_forces.push_back(f);
 
 	return true;
 }
 
+llint BaseParticle::heap_footprint() const {
+	return (llint) int_centers.capacity() * sizeof(LR_vector) + (llint) affected.capacity() * sizeof(ParticlePair) + (llint) ext_forces.capacity() * sizeof(BaseForce *);
+}
+
+void BaseParticle::shrink_to_fit() {
+	int_centers.shrink_to_fit();
+	affected.shrink_to_fit();
+	ext_forces.shrink_to_fit();
+}
+
 void BaseParticle::init() {
 	force = LR_vector(0., 0., 0.);
 	torque = LR_vector(0., 0., 0.);
@@ -36,6 +36,12 @@ public:
 	BaseParticle();
 	virtual ~BaseParticle();
 
+	/// particles (and the objects of all the classes that inherit from BaseParticle) are allocated through a ParticleArena
+	static void *operator new(std::size_t size);
+	static void operator delete(void *ptr);
+	static void *operator new[](std::size_t size);
+	static void operator delete[](void *ptr);
+
 	std::vector<ParticlePair> affected;
 
 	virtual void set_positions() {
@@ -139,6 +145,16 @@ public:
 		return int_centers.size();
 	}
 
+	/**
+	 * @brief Returns the memory allocated on the heap by the per-particle arrays (interaction centres, affected pairs and external forces), in bytes.
+	 */
+	llint heap_footprint() const;
+
+	/**
+	 * @brief Releases the spare capacity of the per-particle arrays. Should be called once they have been filled.
+	 */
+	void shrink_to_fit();
+
 	/// Index of the particle. Usually it is a useful way of accessing arrays of particles
 	int index;
 
@@ -24,6 +24,7 @@ Molecule::~Molecule() {
 void Molecule::add_particle(BaseParticle *p) {
     particles.push_back(p);
     _shiftable_dirty = true;
+    _properties_dirty = true;
 }
 
 void Molecule::normalise() {
@@ -40,6 +41,28 @@ void Molecule::update_com() {
         com += p->pos;
     }
     com /= N();
+    // the other properties may be out of date
+    _properties_dirty = true;
+}
+
+void Molecule::update_properties() {
+    if(!_properties_dirty || N() == 0) {
+        return;
+    }
+
+    LR_vector sum(0., 0., 0.);
+    for(auto p : particles) {
+        sum += p->pos;
+    }
+    com = sum / (number) N();
+
+    number max_sqr_distance = 0.;
+    for(auto p : particles) {
+        max_sqr_distance = std::max(max_sqr_distance, p->pos.sqr_distance(com));
+    }
+    bounding_radius = sqrt(max_sqr_distance);
+
+    _properties_dirty = false;
 }
 
 bool Molecule::shiftable() {
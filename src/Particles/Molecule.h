@@ -20,6 +20,8 @@ struct Molecule {
 
 	std::vector<BaseParticle *> particles;
 	LR_vector com;
+	/// largest distance between the centre of mass and a particle, computed by update_properties()
+	number bounding_radius = 0.;
 
 	/**
 	 * @brief Add a particle to the molecule
@@ -45,6 +47,21 @@ struct Molecule {
 	 */
 	void update_com();
 
+	/**
+	 * @brief Compute the centre of mass and the bounding radius of the molecule
+	 *
+	 * The results are cached and reused until invalidate() is called, so that several observables printed at the
+	 * same step do not have to compute them again. Code that moves particles should call invalidate() afterwards.
+	 */
+	void update_properties();
+
+	/**
+	 * @brief Mark the cached properties as out of date, so that the next call to update_properties() recomputes them
+	 */
+	void invalidate() {
+		_properties_dirty = true;
+	}
+
 	int get_id() {
 		return _id;
 	}
@@ -65,6 +82,9 @@ private:
 	/// @brief true if the shiftable conditions should be re-evaluated
 	bool _shiftable_dirty = false;
 	bool _is_shiftable = true;
+
+	/// true if the properties should be recomputed by the next call to update_properties()
+	bool _properties_dirty = true;
 };
 
 #endif /* SRC_PARTICLES_MOLECULE_H_ */
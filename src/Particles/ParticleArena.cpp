@@ -0,0 +1,103 @@
+/*
+ * ParticleArena.cpp
+ */
+
+#include "ParticleArena.h"
+
+#include <algorithm>
+#include <new>
+
+ParticleArena::ParticleArena() {
+
+}
+
+ParticleArena::~ParticleArena() {
+	// chunks that still contain live objects are intentionally leaked, since particles may outlive the arena
+	// during static destruction
+}
+
+ParticleArena &ParticleArena::instance() {
+	static ParticleArena *arena = new ParticleArena();
+	return *arena;
+}
+
+void *ParticleArena::allocate(std::size_t size) {
+	const std::size_t align = alignof(std::max_align_t);
+	std::size_t total = sizeof(Header) + ((size + align - 1) / align) * align;
+
+	Header *header;
+	if(!_enabled) {
+		header = static_cast<Header *>(::operator new(total));
+		header->chunk = nullptr;
+	}
+	else {
+		std::lock_guard<std::mutex> lock(_mutex);
+		std::size_t needed = total * std::max(_to_reserve, 1);
+		if(_current == nullptr || _current->used + needed > _current->size) {
+			_current = _new_chunk(needed);
+		}
+		_to_reserve = 0;
+		header = reinterpret_cast<Header *>(_current->data + _current->used);
+		header->chunk = _current;
+		_current->used += total;
+		_current->live++;
+	}
+
+	return header + 1;
+}
+
+void ParticleArena::deallocate(void *ptr) {
+	if(ptr == nullptr) {
+		return;
+	}
+
+	Header *header = static_cast<Header *>(ptr) - 1;
+	Chunk *chunk = header->chunk;
+	if(chunk == nullptr) {
+		::operator delete(header);
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	chunk->live--;
+	if(chunk->live == 0) {
+		if(chunk == _current) {
+			// the current chunk is recycled rather than released
+			chunk->used = 0;
+		}
+		else {
+			_release_chunk(chunk);
+		}
+	}
+}
+
+llint ParticleArena::used_bytes() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	llint total = 0;
+	for(auto chunk : _chunks) {
+		total += chunk->used;
+	}
+	return total;
+}
+
+ParticleArena::Chunk *ParticleArena::_new_chunk(std::size_t min_size) {
+	Chunk *chunk = new Chunk();
+	chunk->size = std::max(min_size, CHUNK_SIZE);
+	chunk->data = static_cast<char *>(::operator new(chunk->size));
+	chunk->used = 0;
+	chunk->live = 0;
+	_chunks.push_back(chunk);
+
+	// a chunk that has been left empty by the one we are replacing can be released straight away
+	if(_current != nullptr && _current->live == 0) {
+		_release_chunk(_current);
+	}
+
+	return chunk;
+}
+
+void ParticleArena::_release_chunk(Chunk *chunk) {
+	_chunks.erase(std::find(_chunks.begin(), _chunks.end(), chunk));
+	::operator delete(chunk->data);
+	delete chunk;
+}
@@ -0,0 +1,93 @@
+/*
+ * ParticleArena.h
+ */
+
+#ifndef SRC_PARTICLES_PARTICLEARENA_H_
+#define SRC_PARTICLES_PARTICLEARENA_H_
+
+#include "../defs.h"
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Chunked bump allocator used to allocate particle objects.
+ *
+ * Particles are allocated (through BaseParticle's class-specific operator new and operator new[]) one after the
+ * other in large chunks, so that the startup of simulations of large systems is not dominated by calls to malloc and
+ * particles that are close in index are also close in memory. Each allocation is preceded by a small header that points to the chunk
+ * it belongs to: chunks keep track of the number of objects they contain, and are released as soon as this number
+ * drops to zero. Since particles are allocated and deleted in bulk, no attempt is made to reuse the memory of single
+ * particles.
+ *
+ * Objects allocated while the arena is disabled are allocated on the heap with the global operator new.
+ *
+ * The object returned by instance() is created on first use and never destroyed: particles may be deleted during
+ * static destruction (e.g. when the Python interpreter tears down oxpy objects), after a static arena would have been
+ * destroyed. Chunks are released when they become empty, and the memory of those still in use when the program exits
+ * is reclaimed by the operating system.
+ */
+class ParticleArena {
+public:
+	ParticleArena(const ParticleArena &) = delete;
+	virtual ~ParticleArena();
+
+	static ParticleArena &instance();
+
+	void *allocate(std::size_t size);
+	void deallocate(void *ptr);
+
+	/**
+	 * @brief Makes sure that the next n_objects objects of the same size are allocated one after the other in the same chunk.
+	 *
+	 * This is used to store the particles with a constant stride, so that their data can be accessed through strided views.
+	 *
+	 * @param n_objects
+	 */
+	void reserve(int n_objects) {
+		_to_reserve = n_objects;
+	}
+
+	void set_enabled(bool enabled) {
+		_enabled = enabled;
+	}
+
+	bool enabled() const {
+		return _enabled;
+	}
+
+	/**
+	 * @brief Returns the number of bytes currently taken up by objects (and their headers) in the arena's chunks.
+	 */
+	llint used_bytes();
+
+private:
+	struct Chunk {
+		char *data;
+		std::size_t size;
+		std::size_t used;
+		llint live;
+	};
+
+	/// the header that precedes each allocated object. Its size preserves the alignment of what follows
+	union Header {
+		Chunk *chunk;
+		std::max_align_t alignment;
+	};
+
+	static const std::size_t CHUNK_SIZE = 1 << 20;
+
+	ParticleArena();
+
+	bool _enabled = true;
+	int _to_reserve = 0;
+	std::mutex _mutex;
+	std::vector<Chunk *> _chunks;
+	Chunk *_current = nullptr;
+
+	Chunk *_new_chunk(std::size_t min_size);
+	void _release_chunk(Chunk *chunk);
+};
+
+#endif /* SRC_PARTICLES_PARTICLEARENA_H_ */
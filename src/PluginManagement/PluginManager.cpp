@@ -22,6 +22,7 @@ std::shared_ptr<PluginManager> PluginManager::_manager = nullptr;
 typedef BaseObservable* make_obs();
 typedef BaseInteraction* make_inter();
 typedef BaseMove* make_move();
+typedef void register_kernels(BaseInteraction *);
 
 PluginManager::PluginManager() :
 				_initialised(false),
@@ -176,7 +177,18 @@ InteractionPtr PluginManager::get_interaction(string name) {
 	}
 
 	// now we cast it back to the type required by the code
-	return InteractionPtr((BaseInteraction *)temp_inter);
+	InteractionPtr interaction((BaseInteraction *) temp_inter);
+
+	// the batched kernels are optional, so we do not complain if the plugin does not provide them
+	string kernels_entry = string("register_kernels_") + name;
+	dlerror();
+	register_kernels *register_new_kernels = (register_kernels *) dlsym(handle, kernels_entry.c_str());
+	if(!dlerror() && register_new_kernels != NULL) {
+		register_new_kernels(interaction.get());
+		OX_LOG(Logger::LOG_INFO, "Plugin interaction '%s' registered its batched kernels (neighbour block: %d, energy only: %d)", name.c_str(), interaction->has_neighbour_block_kernel(), interaction->has_energy_block_kernel());
+	}
+
+	return interaction;
 }
 
 MovePtr PluginManager::get_move(std::string name) {
@@ -55,6 +55,21 @@
  extern "C" IBaseInteraction *make_MyInteraction() { return new MyInteraction(); }
  @endcode
  *
+ * Interaction plugins can optionally provide a second entry point, named register_kernels_NAME, which is called
+ * right after the interaction has been built. It can be used to register kernels that compute the non-bonded interaction
+ * between a particle and a whole block of neighbours (see BaseInteraction::register_neighbour_block_kernel()) or only
+ * the corresponding energy (see BaseInteraction::register_energy_block_kernel()). The backends use these kernels in their
+ * force and energy loops, and fall back to the per-pair methods for plugins that do not register them.
+ *
+ * @code
+ extern "C" void register_kernels_MyInteraction(BaseInteraction *interaction) {
+ 	MyInteraction *inter = static_cast<MyInteraction *>(interaction);
+ 	interaction->register_neighbour_block_kernel([inter](BaseParticle *p, const std::vector<BaseParticle *> &neighs, bool update_forces) {
+ 		return inter->my_block_kernel(p, neighs, update_forces);
+ 	});
+ }
+ @endcode
+ *
  * @verbatim
  [plugin_search_path = <string> (a semicolon-separated list of directories where plugins are looked for in, in addition to the current directory.)]
  [plugin_observable_entry_points = <string> (a semicolon-separated list of prefixes which will be used to look for entry points in shared libraries containing observables.)]
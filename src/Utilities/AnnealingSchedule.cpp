@@ -0,0 +1,91 @@
+/*
+ * AnnealingSchedule.cpp
+ */
+
+#include "AnnealingSchedule.h"
+
+#include "oxDNAException.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+AnnealingSchedule::AnnealingSchedule() {
+
+}
+
+AnnealingSchedule::~AnnealingSchedule() {
+
+}
+
+void AnnealingSchedule::get_settings(input_file &inp) {
+	std::string raw_schedule;
+	if(getInputString(&inp, "annealing_schedule", raw_schedule, 0) == KEY_NOT_FOUND) {
+		return;
+	}
+
+	getInputLLInt(&inp, "annealing_every", &_every, 0);
+	if(_every <= 0) {
+		throw oxDNAException("annealing_every should be > 0");
+	}
+
+	for(auto point : Utils::split(raw_schedule, ',')) {
+		Utils::trim(point);
+		if(point.size() == 0) {
+			continue;
+		}
+
+		auto fields = Utils::split(point, ':');
+		if(fields.size() != 2) {
+			throw oxDNAException("Invalid annealing_schedule entry '%s': the expected format is step:T", point.c_str());
+		}
+		Utils::trim(fields[0]);
+		Utils::trim(fields[1]);
+
+		// steps are parsed as floating-point numbers so that values such as 1e6 are accepted
+		char *end;
+		double step = strtod(fields[0].c_str(), &end);
+		if(fields[0].size() == 0 || *end != '\0' || step < 0) {
+			throw oxDNAException("Invalid step '%s' in the annealing_schedule entry '%s'", fields[0].c_str(), point.c_str());
+		}
+		if(fields[1].size() == 0) {
+			throw oxDNAException("Missing temperature in the annealing_schedule entry '%s'", point.c_str());
+		}
+
+		_points.emplace_back((llint) step, Utils::get_temperature(fields[1]));
+	}
+
+	if(_points.size() == 0) {
+		throw oxDNAException("annealing_schedule should contain at least one step:T pair");
+	}
+
+	std::stable_sort(_points.begin(), _points.end(), [](const std::pair<llint, number> &a, const std::pair<llint, number> &b) {
+		return a.first < b.first;
+	});
+
+	for(auto &point : _points) {
+		if(point.second <= (number) 0.) {
+			throw oxDNAException("The temperatures in annealing_schedule should be positive");
+		}
+	}
+
+	OX_LOG(Logger::LOG_INFO, "Using an annealing schedule with %d points, updating the temperature every %lld steps", (int) _points.size(), _every);
+}
+
+number AnnealingSchedule::temperature(llint step) {
+	if(step <= _points.front().first) {
+		return _points.front().second;
+	}
+	if(step >= _points.back().first) {
+		return _points.back().second;
+	}
+
+	// the first point that comes after the given step
+	auto next = std::upper_bound(_points.begin(), _points.end(), step, [](llint s, const std::pair<llint, number> &p) {
+		return s < p.first;
+	});
+	auto prev = next - 1;
+
+	number fraction = (step - prev->first) / (number) (next->first - prev->first);
+	return prev->second + fraction * (next->second - prev->second);
+}
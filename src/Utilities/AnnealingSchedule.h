@@ -0,0 +1,64 @@
+/*
+ * AnnealingSchedule.h
+ */
+
+#ifndef ANNEALINGSCHEDULE_H_
+#define ANNEALINGSCHEDULE_H_
+
+#include "../defs.h"
+
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Changes the temperature of a running simulation according to a user-defined schedule.
+ *
+ * The schedule is a list of (step, temperature) points: between two consecutive points the temperature is linearly
+ * interpolated, while before the first and after the last point it is kept constant. The temperature is updated
+ * through ConfigInfo::update_temperature, so that all the objects that depend on it (interactions, thermostats, MC
+ * moves) are notified. Interactions only update their temperature-dependent coefficients and do not get
+ * re-initialised from scratch.
+ *
+ * @verbatim
+[annealing_schedule = <string> (comma-separated list of step:T pairs, e.g. "0:50C, 1e6:20C, 2e6:20C". Temperatures can be given in any of the units supported by the T key. If set, the temperature of the simulation follows the schedule and the T key only sets the initial temperature)]
+[annealing_every = <int> (number of time steps between two temperature updates. Defaults to 1000)]
+@endverbatim
+ */
+class AnnealingSchedule {
+public:
+	AnnealingSchedule();
+	AnnealingSchedule(const AnnealingSchedule &) = delete;
+	virtual ~AnnealingSchedule();
+
+	void get_settings(input_file &inp);
+
+	/**
+	 * @brief Returns true if the user provided an annealing schedule.
+	 */
+	bool enabled() {
+		return _points.size() > 0;
+	}
+
+	/**
+	 * @brief Returns true if the temperature should be updated at the given step.
+	 *
+	 * @param step
+	 */
+	bool is_due(llint step) {
+		return enabled() && (step % _every) == 0;
+	}
+
+	/**
+	 * @brief Returns the temperature (in simulation units) prescribed by the schedule at the given step.
+	 *
+	 * @param step
+	 */
+	number temperature(llint step);
+
+private:
+	/// (step, temperature) pairs, sorted by step
+	std::vector<std::pair<llint, number>> _points;
+	llint _every = 1000;
+};
+
+#endif /* ANNEALINGSCHEDULE_H_ */
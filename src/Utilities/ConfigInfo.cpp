@@ -18,7 +18,10 @@ std::shared_ptr<ConfigInfo> ConfigInfo::_config_info = nullptr;
 ConfigInfo::ConfigInfo(std::vector<BaseParticle *> *ps, std::vector<std::shared_ptr<Molecule>> *mols) :
 				particles_pointer(ps),
 				molecules_pointer(mols) {
-
+	// the order should match the one of the enum in the header
+	register_event("T_updated");
+	register_event("box_initialised");
+	register_event("box_updated");
 }
 
 ConfigInfo::~ConfigInfo() {
@@ -27,7 +30,7 @@ ConfigInfo::~ConfigInfo() {
 
 void ConfigInfo::update_temperature(number new_T) {
 	_temperature = new_T;
-	notify("T_updated");
+	notify(T_UPDATED);
 }
 
 void ConfigInfo::add_force_to_particles(std::shared_ptr<BaseForce> force, std::vector<int> particle_ids, std::string force_description) {
@@ -67,13 +70,92 @@ ObservablePtr ConfigInfo::get_observable_by_id(std::string id) {
 	return nullptr;
 }
 
-void ConfigInfo::subscribe(std::string event, std::function<void()> callback) {
+ConfigInfo::EventHandle ConfigInfo::register_event(const std::string &event) {
+	auto it = _event_handles.find(event);
+	if(it != _event_handles.end()) {
+		return it->second;
+	}
+
+	EventHandle handle = _event_callbacks.size();
+	_event_handles[event] = handle;
+	_event_callbacks.emplace_back();
+	_event_owners.emplace_back();
+	_is_pending.push_back(false);
+
+	return handle;
+}
+
+void ConfigInfo::subscribe(EventHandle event, std::function<void()> callback, const void *owner) {
+	if(event < 0 || event >= (EventHandle) _event_callbacks.size()) {
+		throw oxDNAException("Cannot subscribe to the unregistered event %d", event);
+	}
 	_event_callbacks[event].emplace_back(callback);
+	_event_owners[event].push_back(owner);
+}
+
+void ConfigInfo::subscribe(const std::string &event, std::function<void()> callback, const void *owner) {
+	subscribe(register_event(event), callback, owner);
+}
+
+void ConfigInfo::unsubscribe(const void *owner) {
+	if(owner == nullptr) {
+		return;
+	}
+
+	for(uint event = 0; event < _event_callbacks.size(); event++) {
+		auto &callbacks = _event_callbacks[event];
+		auto &owners = _event_owners[event];
+		uint kept = 0;
+		for(uint i = 0; i < callbacks.size(); i++) {
+			if(owners[i] != owner) {
+				callbacks[kept] = std::move(callbacks[i]);
+				owners[kept] = owners[i];
+				kept++;
+			}
+		}
+		callbacks.resize(kept);
+		owners.resize(kept);
+	}
+}
+
+void ConfigInfo::notify(EventHandle event) {
+	if(event < 0 || event >= (EventHandle) _event_callbacks.size()) {
+		throw oxDNAException("Cannot notify the unregistered event %d", event);
+	}
+	// callbacks may subscribe to events, which may invalidate iterators
+	for(uint i = 0; i < _event_callbacks[event].size(); i++) {
+		_event_callbacks[event][i]();
+	}
+}
+
+void ConfigInfo::notify(const std::string &event) {
+	auto it = _event_handles.find(event);
+	// nobody can be subscribed to an event that has not been registered
+	if(it != _event_handles.end()) {
+		notify(it->second);
+	}
 }
 
-void ConfigInfo::notify(std::string event) {
-	for(auto callback : _event_callbacks[event]) {
-		callback();
+void ConfigInfo::notify_deferred(EventHandle event) {
+	if(event < 0 || event >= (EventHandle) _event_callbacks.size()) {
+		throw oxDNAException("Cannot notify the unregistered event %d", event);
+	}
+	if(!_is_pending[event]) {
+		_is_pending[event] = true;
+		_pending_events.push_back(event);
+	}
+}
+
+void ConfigInfo::flush_events() {
+	if(_pending_events.empty()) {
+		return;
+	}
+
+	std::vector<EventHandle> to_notify;
+	to_notify.swap(_pending_events);
+	for(auto event : to_notify) {
+		_is_pending[event] = false;
+		notify(event);
 	}
 }
 
@@ -101,3 +183,47 @@ const FlattenedConfigInfo &ConfigInfo::flattened_conf() {
 	_flattened_conf.update(curr_step, particles());
 	return _flattened_conf;
 }
+
+void ConfigInfo::begin_observable_batch() {
+	_batch.active = true;
+	_batch.has_energy = false;
+	_batch.has_energy_split = false;
+}
+
+void ConfigInfo::end_observable_batch() {
+	_batch.active = false;
+	_batch.has_energy = false;
+	_batch.has_energy_split = false;
+	_batch.energy_split.clear();
+}
+
+number ConfigInfo::system_energy() {
+	if(_batch.active && _batch.has_energy) {
+		// we also restore the flag so that callers that check it behave as if the energy had been just computed
+		interaction->set_is_infinite(_batch.energy_is_infinite);
+		return _batch.energy;
+	}
+
+	number energy = interaction->get_system_energy(particles(), lists);
+	if(_batch.active) {
+		_batch.energy = energy;
+		_batch.energy_is_infinite = interaction->get_is_infinite();
+		_batch.has_energy = true;
+	}
+
+	return energy;
+}
+
+std::map<int, number> ConfigInfo::system_energy_split() {
+	if(_batch.active && _batch.has_energy_split) {
+		return _batch.energy_split;
+	}
+
+	auto energies = interaction->get_system_energy_split(particles(), lists);
+	if(_batch.active) {
+		_batch.energy_split = energies;
+		_batch.has_energy_split = true;
+	}
+
+	return energies;
+}
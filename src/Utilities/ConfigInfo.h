@@ -46,13 +46,42 @@ private:
 
 	static std::shared_ptr<ConfigInfo> _config_info;
 
-	/// A map associating list of callbacks to events
-	std::map<std::string, std::vector<std::function<void()>>> _event_callbacks;
+public:
+	/// Integer handle that identifies an event
+	using EventHandle = int;
+
+	/// Events that are always registered
+	enum {
+		T_UPDATED = 0,
+		BOX_INITIALISED,
+		BOX_UPDATED
+	};
+
+private:
+	/// The list of callbacks associated to each event, indexed by event handle
+	std::vector<std::vector<std::function<void()>>> _event_callbacks;
+	/// The object that owns each callback (or nullptr), used to remove all the callbacks of an object before it is destroyed
+	std::vector<std::vector<const void *>> _event_owners;
+	/// Associates event names to their handles. Used only when events are registered or referred to by name
+	std::map<std::string, EventHandle> _event_handles;
+	/// Events whose notification has been deferred, in order of notification
+	std::vector<EventHandle> _pending_events;
+	std::vector<bool> _is_pending;
 
 	number _temperature = 0.;
 
 	FlattenedConfigInfo _flattened_conf;
 
+	/// cached results of the system-wide sweeps shared by the observables that are printed on the same step
+	struct {
+		bool active = false;
+		bool has_energy = false;
+		bool energy_is_infinite = false;
+		number energy = 0.;
+		bool has_energy_split = false;
+		std::map<int, number> energy_split;
+	} _batch;
+
 public:
 	virtual ~ConfigInfo();
 
@@ -66,9 +95,54 @@ public:
 	 */
 	void set(BaseInteraction *i, std::string *info, BaseList *l, BaseBox *abox);
 
-	void subscribe(std::string event, std::function<void()> callback);
+	/**
+	 * @brief Returns the handle associated to the given event name, registering the event if required.
+	 *
+	 * @param event
+	 * @return
+	 */
+	EventHandle register_event(const std::string &event);
+
+	/**
+	 * @brief Associates a callback to the given event.
+	 *
+	 * @param event
+	 * @param callback
+	 * @param owner the object the callback refers to. Objects that may be destroyed before the end of the simulation should set it and call unsubscribe() when they are destroyed
+	 */
+	void subscribe(EventHandle event, std::function<void()> callback, const void *owner=nullptr);
 
-	void notify(std::string event);
+	void subscribe(const std::string &event, std::function<void()> callback, const void *owner=nullptr);
+
+	/**
+	 * @brief Removes all the callbacks that have been subscribed by the given owner.
+	 *
+	 * @param owner
+	 */
+	void unsubscribe(const void *owner);
+
+	/**
+	 * @brief Invokes straight away all the callbacks associated to the given event.
+	 *
+	 * @param event
+	 */
+	void notify(EventHandle event);
+
+	void notify(const std::string &event);
+
+	/**
+	 * @brief Marks the given event as triggered. Its callbacks will be invoked, only once, on the next call to flush_events().
+	 *
+	 * This should be used for events that can be triggered many times during a single simulation step (e.g. box updates in NPT simulations).
+	 *
+	 * @param event
+	 */
+	void notify_deferred(EventHandle event);
+
+	/**
+	 * @brief Invokes the callbacks of all the events that have been triggered through notify_deferred() since the last call. Called by the managers after each simulation step.
+	 */
+	void flush_events();
 
 	int N() {
 		return particles_pointer->size();
@@ -97,6 +171,15 @@ public:
 
 	static void clear();
 
+	/**
+	 * @brief Returns true if the ConfigInfo object exists, i.e. if init() has been called and clear() has not.
+	 *
+	 * Objects that unsubscribe from events in their destructors should check it first, since they may outlive the ConfigInfo object
+	 */
+	static bool initialised() {
+		return _config_info != nullptr;
+	}
+
 	std::vector<BaseParticle *> &particles() {
 		return *particles_pointer;
 	}
@@ -107,6 +190,33 @@ public:
 
 	const FlattenedConfigInfo &flattened_conf();
 
+	/**
+	 * @brief Signals that a group of observables is about to be computed on the same configuration.
+	 *
+	 * Until end_observable_batch() is called, the results of the system-wide sweeps requested through system_energy()
+	 * and system_energy_split() are computed once and then shared by all the observables.
+	 */
+	void begin_observable_batch();
+
+	/**
+	 * @brief Closes the batch opened by begin_observable_batch() and drops the cached results.
+	 */
+	void end_observable_batch();
+
+	/**
+	 * @brief Returns the total potential energy of the system, as computed by the interaction.
+	 *
+	 * The value is cached if an observable batch is open.
+	 */
+	number system_energy();
+
+	/**
+	 * @brief Returns the potential energy of the system split into its contributions, as computed by the interaction.
+	 *
+	 * The value is cached if an observable batch is open.
+	 */
+	std::map<int, number> system_energy_split();
+
 	/// Pointer to the array that stores all the particles' information.
 	std::vector<BaseParticle *> *particles_pointer;
 
@@ -50,3 +50,67 @@ void FlattenedConfigInfo::update(long long int step, const std::vector<BaseParti
 		types[i] = p->type;
 	}
 }
+
+static number *_field_pointer(BaseParticle *p, ParticleFieldView::Field field) {
+	switch(field) {
+	case ParticleFieldView::POSITIONS:
+		return &p->pos.x;
+	case ParticleFieldView::VELOCITIES:
+		return &p->vel.x;
+	case ParticleFieldView::ANGULAR_MOMENTA:
+		return &p->L.x;
+	case ParticleFieldView::FORCES:
+		return &p->force.x;
+	case ParticleFieldView::TORQUES:
+		return &p->torque.x;
+	default:
+		return &p->orientation.v1.x;
+	}
+}
+
+ParticleFieldView::ParticleFieldView(std::vector<BaseParticle *> &particles, Field field) :
+				_field(field),
+				_rows(particles.size()) {
+	if(_rows == 0) {
+		return;
+	}
+
+	char *first = (char *) _field_pointer(particles[0], field);
+	_stride = (_rows > 1) ? (char *) _field_pointer(particles[1], field) - first : (std::ptrdiff_t) (cols() * sizeof(number));
+	_zero_copy = _stride != 0;
+	for(int i = 2; i < _rows && _zero_copy; i++) {
+		_zero_copy = ((char *) _field_pointer(particles[i], field) - first) == i * _stride;
+	}
+
+	if(_zero_copy) {
+		_base = (number *) first;
+	}
+	else {
+		_stride = cols() * sizeof(number);
+		_copy.resize(_rows * cols());
+		for(int i = 0; i < _rows; i++) {
+			number *src = _field_pointer(particles[i], field);
+			std::copy(src, src + cols(), _copy.begin() + i * cols());
+		}
+		_base = _copy.data();
+	}
+}
+
+ParticleFieldView::Field ParticleFieldView::field_from_string(const std::string &name) {
+	if(name == "positions") return POSITIONS;
+	if(name == "velocities") return VELOCITIES;
+	if(name == "angular_momenta") return ANGULAR_MOMENTA;
+	if(name == "forces") return FORCES;
+	if(name == "torques") return TORQUES;
+	if(name == "orientations") return ORIENTATIONS;
+
+	throw oxDNAException("Unknown particle field '%s' (supported fields: positions, velocities, angular_momenta, forces, torques, orientations)", name.c_str());
+}
+
+number *ParticleFieldView::data() {
+	return _base;
+}
+
+std::ptrdiff_t ParticleFieldView::row_stride() {
+	return _stride;
+}
@@ -12,6 +12,8 @@
 
 #include <vector>
 #include <memory>
+#include <string>
+#include <cstddef>
 
 class BaseParticle;
 
@@ -35,4 +37,48 @@ struct FlattenedConfigInfo {
 	long long int last_updated = -1;
 };
 
+/**
+ * @brief A view of a per-particle quantity (e.g. the positions) as a N x cols() matrix.
+ *
+ * If the particles are stored in memory with a constant stride (which is the case when they are allocated by the
+ * ParticleArena) the view points directly to the particles' data, and changes made through it are reflected in the
+ * simulation. Otherwise, the view stores a read-only copy of the data.
+ */
+struct ParticleFieldView {
+	enum Field {
+		POSITIONS, VELOCITIES, ANGULAR_MOMENTA, FORCES, TORQUES, ORIENTATIONS
+	};
+
+	ParticleFieldView(std::vector<BaseParticle *> &particles, Field field);
+
+	/// returns the field associated to the given name (positions, velocities, angular_momenta, forces, torques or orientations)
+	static Field field_from_string(const std::string &name);
+
+	int rows() {
+		return _rows;
+	}
+
+	int cols() {
+		return (_field == ORIENTATIONS) ? 9 : 3;
+	}
+
+	bool is_zero_copy() {
+		return _zero_copy;
+	}
+
+	/// pointer to the first element of the view
+	number *data();
+
+	/// distance, in bytes, between the data of two consecutive particles
+	std::ptrdiff_t row_stride();
+
+private:
+	Field _field;
+	int _rows = 0;
+	bool _zero_copy = false;
+	number *_base = nullptr;
+	std::ptrdiff_t _stride = 0;
+	std::vector<number> _copy;
+};
+
 #endif /* SRC_UTILITIES_FLATTENEDCONFIGINFO_H_ */
@@ -0,0 +1,222 @@
+/*
+ * MetricsExporter.cpp
+ */
+
+#include "MetricsExporter.h"
+
+#include "oxDNAException.h"
+#include "Utils.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+
+MetricsExporter::MetricsExporter() :
+				_stop_worker(false) {
+
+}
+
+MetricsExporter::~MetricsExporter() {
+	stop();
+}
+
+void MetricsExporter::get_settings(input_file &inp) {
+	getInputInt(&inp, "metrics_port", &_port, 0);
+	getInputString(&inp, "metrics_file", _filename, 0);
+
+	int print_energy_every = 0;
+	getInputInt(&inp, "print_energy_every", &print_energy_every, 0);
+	_every = print_energy_every;
+	getInputLLInt(&inp, "metrics_every", &_every, 0);
+
+	if(_port < 0 || _port > 65535) {
+		throw oxDNAException("Invalid metrics_port %d: it should be a number between 1 and 65535", _port);
+	}
+
+	if(enabled() && _every <= 0) {
+		throw oxDNAException("metrics_every should be > 0 when metrics_port or metrics_file are set");
+	}
+}
+
+void MetricsExporter::init() {
+	if(!enabled()) {
+		return;
+	}
+
+	if(_port > 0) {
+		_open_socket();
+		OX_LOG(Logger::LOG_INFO, "Serving metrics on http://127.0.0.1:%d/metrics every %lld steps", _port, _every);
+	}
+	if(_filename.size() > 0) {
+		OX_LOG(Logger::LOG_INFO, "Writing metrics to '%s' every %lld steps", _filename.c_str(), _every);
+	}
+
+	_stop_worker = false;
+	_worker = std::thread(&MetricsExporter::_work, this);
+}
+
+void MetricsExporter::stop() {
+	if(_worker.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop_worker = true;
+		}
+		_cv.notify_all();
+		_worker.join();
+	}
+
+	if(_socket >= 0) {
+		close(_socket);
+		_socket = -1;
+	}
+}
+
+void MetricsExporter::_open_socket() {
+	_socket = socket(AF_INET, SOCK_STREAM, 0);
+	if(_socket < 0) {
+		throw oxDNAException("Cannot create the metrics socket");
+	}
+
+	int reuse = 1;
+	setsockopt(_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+	sockaddr_in address;
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = htons(_port);
+
+	if(bind(_socket, (sockaddr *) &address, sizeof(address)) < 0) {
+		close(_socket);
+		_socket = -1;
+		throw oxDNAException("Cannot bind the metrics socket to port %d", _port);
+	}
+
+	if(listen(_socket, 8) < 0) {
+		close(_socket);
+		_socket = -1;
+		throw oxDNAException("Cannot listen on the metrics socket (port %d)", _port);
+	}
+}
+
+void MetricsExporter::publish(const std::vector<metric> &metrics) {
+	// the text is rendered outside of the critical section, which only performs a swap
+	std::stringstream ss;
+	ss.precision(10);
+	for(auto &m : metrics) {
+		ss << m.first << " " << m.second << "\n";
+	}
+	std::string new_text = ss.str();
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_text.swap(new_text);
+		_file_dirty = true;
+	}
+	_cv.notify_all();
+}
+
+void MetricsExporter::_work() {
+	while(!_stop_worker) {
+		if(_socket >= 0) {
+			pollfd pfd;
+			pfd.fd = _socket;
+			pfd.events = POLLIN;
+			pfd.revents = 0;
+			if(poll(&pfd, 1, 200) > 0 && (pfd.revents & POLLIN)) {
+				int fd = accept(_socket, nullptr, nullptr);
+				if(fd >= 0) {
+					_serve_connection(fd);
+					close(fd);
+				}
+			}
+		}
+		else {
+			std::unique_lock<std::mutex> lock(_mutex);
+			_cv.wait_for(lock, std::chrono::milliseconds(200), [this]() { return _file_dirty || _stop_worker; });
+		}
+
+		if(_filename.size() > 0) {
+			std::string to_write;
+			bool dirty = false;
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				if(_file_dirty) {
+					to_write = _text;
+					_file_dirty = false;
+					dirty = true;
+				}
+			}
+			if(dirty) {
+				_write_file(to_write);
+			}
+		}
+	}
+}
+
+void MetricsExporter::_serve_connection(int fd) {
+	// slow clients should not keep the thread busy for too long
+	timeval timeout;
+	timeout.tv_sec = 1;
+	timeout.tv_usec = 0;
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+	std::string request;
+	char buffer[1024];
+	while(request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+		ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+		if(n <= 0) {
+			break;
+		}
+		request.append(buffer, n);
+	}
+
+	std::string status = "200 OK";
+	std::string body;
+	if(request.compare(0, 4, "GET ") != 0) {
+		status = "400 Bad Request";
+	}
+	else {
+		std::string path = request.substr(4, request.find(' ', 4) - 4);
+		if(path == "/" || path.compare(0, 8, "/metrics") == 0) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			body = _text;
+		}
+		else {
+			status = "404 Not Found";
+		}
+	}
+
+	std::string response = Utils::sformat("HTTP/1.0 %s\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %u\r\nConnection: close\r\n\r\n", status.c_str(), (uint) body.size()) + body;
+	size_t sent = 0;
+	while(sent < response.size()) {
+		ssize_t n = send(fd, response.c_str() + sent, response.size() - sent, MSG_NOSIGNAL);
+		if(n <= 0) {
+			break;
+		}
+		sent += n;
+	}
+}
+
+void MetricsExporter::_write_file(const std::string &text) {
+	// we write to a temporary file and then rename it so that readers never see a partially-written file
+	std::string tmp_name = _filename + ".tmp";
+	FILE *out = fopen(tmp_name.c_str(), "w");
+	if(out == NULL) {
+		OX_LOG(Logger::LOG_WARNING, "Cannot open '%s' to write the metrics", tmp_name.c_str());
+		return;
+	}
+	fwrite(text.c_str(), sizeof(char), text.size(), out);
+	fclose(out);
+	if(rename(tmp_name.c_str(), _filename.c_str()) != 0) {
+		OX_LOG(Logger::LOG_WARNING, "Cannot rename '%s' to '%s'", tmp_name.c_str(), _filename.c_str());
+	}
+}
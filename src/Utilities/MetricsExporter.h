@@ -0,0 +1,92 @@
+/*
+ * MetricsExporter.h
+ */
+
+#ifndef METRICSEXPORTER_H_
+#define METRICSEXPORTER_H_
+
+#include "../defs.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Exports live metrics (performance, energies, acceptance ratios, memory usage) of a running simulation.
+ *
+ * The metrics can be either served in Prometheus' text format by a minimal HTTP server listening on the loopback
+ * interface (so that they can be retrieved with, e.g., curl http://127.0.0.1:<port>/metrics) or periodically
+ * written to a file. The simulation thread only renders the metrics and swaps them in: serving HTTP requests and
+ * writing files are done by a separate thread, so that slow or stuck readers never stall the simulation.
+ *
+ * @verbatim
+[metrics_port = <int> (if > 0, serve the metrics over HTTP on 127.0.0.1:<port>. Defaults to 0)]
+[metrics_file = <path> (if set, the metrics will be written to this file each time they are updated)]
+[metrics_every = <int> (number of time steps between two metrics updates. Defaults to print_energy_every)]
+@endverbatim
+ */
+class MetricsExporter {
+public:
+	using metric = std::pair<std::string, number>;
+
+	MetricsExporter();
+	MetricsExporter(const MetricsExporter &) = delete;
+	virtual ~MetricsExporter();
+
+	void get_settings(input_file &inp);
+	void init();
+
+	/**
+	 * @brief Returns true if the user asked for the metrics to be exported.
+	 */
+	bool enabled() {
+		return _port > 0 || _filename.size() > 0;
+	}
+
+	/**
+	 * @brief Returns true if the metrics should be updated at the given step.
+	 *
+	 * @param step
+	 */
+	bool is_due(llint step) {
+		return enabled() && _every > 0 && (step % _every) == 0;
+	}
+
+	/**
+	 * @brief Renders the given metrics and makes them available to the exporting thread. It never blocks on I/O.
+	 *
+	 * Metric names may contain Prometheus labels (e.g. oxdna_acceptance_ratio{move="0"}).
+	 *
+	 * @param metrics the list of (name, value) pairs to be exported
+	 */
+	void publish(const std::vector<metric> &metrics);
+
+	/**
+	 * @brief Stops the exporting thread and releases the socket.
+	 */
+	void stop();
+
+private:
+	int _port = 0;
+	std::string _filename;
+	llint _every = 0;
+
+	int _socket = -1;
+	std::thread _worker;
+	std::mutex _mutex;
+	std::condition_variable _cv;
+	std::atomic<bool> _stop_worker;
+	bool _file_dirty = false;
+	std::string _text;
+
+	void _open_socket();
+	void _work();
+	void _serve_connection(int fd);
+	void _write_file(const std::string &text);
+};
+
+#endif /* METRICSEXPORTER_H_ */
@@ -12,6 +12,7 @@
 #include "../Particles/RNANucleotide.h"
 
 #include <sstream>
+#include <unistd.h>
 
 using std::string;
 
@@ -252,6 +253,22 @@ number get_temperature(std::string raw_T) {
 	return T;
 }
 
+llint get_resident_memory() {
+	long pages = 0;
+	long resident = 0;
+	FILE *statm = fopen("/proc/self/statm", "r");
+	if(statm == NULL) {
+		return -1;
+	}
+	int res = fscanf(statm, "%ld %ld", &pages, &resident);
+	fclose(statm);
+	if(res != 2) {
+		return -1;
+	}
+
+	return (llint) resident * (llint) sysconf(_SC_PAGESIZE);
+}
+
 std::string bytes_to_human(llint bytes) {
 	llint base = 1024;
 	int ctr = 0;
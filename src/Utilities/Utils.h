@@ -186,6 +186,11 @@ void get_seed(unsigned short *seedptr);
  */
 std::string bytes_to_human(llint arg);
 
+/**
+ * @brief Returns the resident set size of the current process, in bytes, or -1 if it cannot be computed.
+ */
+llint get_resident_memory();
+
 /**
  * @brief Utility function that reads a string like "10-16,18" and returns a vector of integers.
  * @param particles pointer to array of particle pointers
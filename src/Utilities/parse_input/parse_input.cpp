@@ -23,10 +23,39 @@ input_file *input_file::main_input = nullptr;
 std::set<std::string> input_file::true_values = {"true", "1", "yes", "yup", "of course"};
 std::set<std::string> input_file::false_values = {"false", "0", "no", "nope", "are you crazy?"};
 
+input_value::input_value(std::string k, std::string v) :
+				key(k),
+				value(v) {
+	// most values do not contain any expression, and hence do not need to be expanded
+	if(value.find('$') == std::string::npos) {
+		expanded_value = value;
+		expanded = true;
+		return;
+	}
+
+	// here we match patterns that are like this: $(some_text), and we use parentheses to make sure that the second element of the std::smatch is "some_text"
+	static const std::regex pattern("\\$\\(([\\w\\[\\]]+)\\)"); // backslashes have to be escaped or the compiler complains
+
+	std::smatch m;
+	std::string to_search = value;
+	while(std::regex_search(to_search, m, pattern)) {
+		depends_on.push_back(m[1].str());
+		to_search = m.suffix().str();
+	}
+}
+
 bool input_value::has_dependencies() {
 	return !depends_on.empty();
 }
 
+bool input_value::is_expanded() {
+	if(!expanded) {
+		return false;
+	}
+
+	return !has_dependencies() || (input_file::main_input != nullptr && expanded_version == input_file::main_input->version);
+}
+
 void input_value::expand_value(std::map<std::string, std::string> expanded_dependency_values) {
 	expanded_value = value;
 	for(auto k : depends_on) {
@@ -36,8 +65,16 @@ void input_value::expand_value(std::map<std::string, std::string> expanded_depen
 		expanded_value.replace(pos, to_sub.length(), expanded_dependency_values[k]);
 	}
 
+	expanded = true;
+	expanded_version = (input_file::main_input != nullptr) ? input_file::main_input->version : 0;
+	number_cached = false;
+
+	if(expanded_value.find("${") == std::string::npos) {
+		return;
+	}
+
 	// here we match patterns that are like this: ${some_text}, and we use parentheses to make sure that the second element of the std::smatch is "some_text"
-	std::regex pattern("\\$\\{(.*)\\}"); // backslashes have to be escaped or the compiler complains
+	static const std::regex pattern("\\$\\{(.*)\\}"); // backslashes have to be escaped or the compiler complains
 	std::smatch m;
 	std::string to_search = expanded_value;
 	exprtk::parser<double> parser;
@@ -56,6 +93,15 @@ void input_value::expand_value(std::map<std::string, std::string> expanded_depen
 	}
 }
 
+double input_value::number_value() {
+	if(!number_cached) {
+		cached_number = std::atof(expanded_value.c_str());
+		number_cached = true;
+	}
+
+	return cached_number;
+}
+
 input_file::input_file(bool is_main) :
 				is_main_input(is_main) {
 	if(is_main) {
@@ -199,44 +245,57 @@ void input_file::set_unread_keys() {
 	}
 }
 
-std::string input_file::get_value(std::string key, int mandatory, bool &found) {
-	found = false;
-	std::map<string, input_value>::iterator it = keys.find(string(key));
-	if(it != keys.end()) {
-		input_value &value = it->second;
-		value.read++;
+input_value *input_file::get_input_value(const std::string &key, int mandatory) {
+	input_map::iterator it = keys.find(key);
+	if(it == keys.end()) {
+		if(mandatory) {
+			throw oxDNAException("Mandatory key `%s' not found", key.c_str());
+		}
+		return nullptr;
+	}
+
+	input_value &value = it->second;
+	value.read++;
 
-		// this lambda recursively checks that there are no circular dependencies and expands all the values of the involved keys
-		std::function<void(std::string,input_value &)> expand_value = [&expand_value](std::string root_key, input_value &current_value) {
-			std::map<std::string, std::string> expanded_dependency_values;
-			for(const auto &k : current_value.depends_on) {
-				if(k == root_key) {
-					throw oxDNAException("Circular dependency found between keys '%s' and '%s', aborting", root_key.c_str(), current_value.key.c_str());
-				}
-				auto dep_it = input_file::main_input->keys.find(k);
-				if(dep_it == input_file::main_input->keys.end()) {
-					throw oxDNAException("Key '%s' (which is expanded by '%s') is not defined", k.c_str(), current_value.key.c_str());
-				}
-				input_value &dep_value = input_file::main_input->keys[k];
+	if(value.is_expanded()) {
+		return &value;
+	}
+
+	// this lambda recursively checks that there are no circular dependencies and expands all the values of the involved keys
+	std::function<void(const std::string &, input_value &)> expand_value = [&expand_value](const std::string &root_key, input_value &current_value) {
+		std::map<std::string, std::string> expanded_dependency_values;
+		for(const auto &k : current_value.depends_on) {
+			if(k == root_key) {
+				throw oxDNAException("Circular dependency found between keys '%s' and '%s', aborting", root_key.c_str(), current_value.key.c_str());
+			}
+			if(input_file::main_input == nullptr) {
+				throw oxDNAException("Key '%s' (which is expanded by '%s') cannot be found since there is no main input file", k.c_str(), current_value.key.c_str());
+			}
+			auto dep_it = input_file::main_input->keys.find(k);
+			if(dep_it == input_file::main_input->keys.end()) {
+				throw oxDNAException("Key '%s' (which is expanded by '%s') is not defined", k.c_str(), current_value.key.c_str());
+			}
+			input_value &dep_value = dep_it->second;
 
+			if(!dep_value.is_expanded()) {
 				expand_value(root_key, dep_value);
-				expanded_dependency_values[k] = dep_value.expanded_value;
 			}
-			current_value.expand_value(expanded_dependency_values);
-		};
+			expanded_dependency_values[k] = dep_value.expanded_value;
+		}
+		current_value.expand_value(expanded_dependency_values);
+	};
 
-		// here we launch the recursive variable expansion
-		expand_value(key, value);
+	// here we launch the recursive variable expansion
+	expand_value(key, value);
 
-		found = true;
-		return value.expanded_value;
-	}
-	else if(mandatory) {
-		throw oxDNAException("Mandatory key `%s' not found", key.c_str());
-	}
-	else {
-		return "";
-	}
+	return &value;
+}
+
+std::string input_file::get_value(const std::string &key, int mandatory, bool &found) {
+	input_value *value = get_input_value(key, mandatory);
+	found = (value != nullptr);
+
+	return (found) ? value->expanded_value : "";
 }
 
 void input_file::set_value(std::string key, std::string value) {
@@ -250,24 +309,15 @@ void input_file::set_value(std::string key, std::string value) {
 	input_map::iterator old_val = keys.find(key);
 	if(old_val != keys.end() && show_overwrite_warnings) {
 		OX_LOG(Logger::LOG_WARNING, "Overwriting key `%s' (`%s' to `%s')", key.c_str(), old_val->second.value.c_str(), value.c_str());
-		keys[key].depends_on.clear();
 	}
+	// the constructor also takes care of finding the keys this value depends on
 	keys[key] = input_value(key, value);
-
-	// now we update the dependencies
-
-	// here we match patterns that are like this: $(some_text), and we use parentheses to make sure that the second element of the std::smatch is "some_text"
-	std::regex pattern("\\$\\(([\\w\\[\\]]+)\\)"); // backslashes have to be escaped or the compiler complains
-
-	std::smatch m;
-	while(std::regex_search(value, m, pattern)) {
-		keys[key].depends_on.push_back(m[1].str());
-		value = m.suffix().str();
-	}
+	version++;
 }
 
 void input_file::unset_value(std::string key) {
 	keys.erase(key);
+	version++;
 }
 
 std::string input_file::to_string() const {
@@ -386,13 +436,12 @@ int getInputString(input_file *inp, const char *skey, char *dest, int mandatory)
 }
 
 int getInputInt(input_file *inp, const char *skey, int *dest, int mandatory) {
-	bool found;
-	std::string value = inp->get_value(skey, mandatory, found);
-	if(!found) {
+	input_value *value = inp->get_input_value(skey, mandatory);
+	if(value == nullptr) {
 		return KEY_NOT_FOUND;
 	}
 
-	*dest = (int) std::floor(std::atof(value.c_str()) + 0.1);
+	*dest = (int) std::floor(value->number_value() + 0.1);
 
 	return KEY_FOUND;
 }
@@ -435,49 +484,45 @@ int getInputBoolAsInt(input_file *inp, const char *skey, int *dest, int mandator
 }
 
 int getInputLLInt(input_file *inp, const char *skey, long long int *dest, int mandatory) {
-	bool found;
-	std::string value = inp->get_value(skey, mandatory, found);
-	if(!found) {
+	input_value *value = inp->get_input_value(skey, mandatory);
+	if(value == nullptr) {
 		return KEY_NOT_FOUND;
 	}
 
-	*dest = (long long) std::floor(std::atof(value.c_str()) + 0.1);
+	*dest = (long long) std::floor(value->number_value() + 0.1);
 
 	return KEY_FOUND;
 }
 
 int getInputUInt(input_file *inp, const char *skey, unsigned int *dest, int mandatory) {
-	bool found;
-	std::string value = inp->get_value(skey, mandatory, found);
-	if(!found) {
+	input_value *value = inp->get_input_value(skey, mandatory);
+	if(value == nullptr) {
 		return KEY_NOT_FOUND;
 	}
 
-	*dest = (unsigned int) floor(atof(value.c_str()) + 0.1);
+	*dest = (unsigned int) floor(value->number_value() + 0.1);
 
 	return KEY_FOUND;
 }
 
 int getInputDouble(input_file *inp, const char *skey, double *dest, int mandatory) {
-	bool found;
-	std::string value = inp->get_value(skey, mandatory, found);
-	if(!found) {
+	input_value *value = inp->get_input_value(skey, mandatory);
+	if(value == nullptr) {
 		return KEY_NOT_FOUND;
 	}
 
-	*dest = std::atof(value.c_str());
+	*dest = value->number_value();
 
 	return KEY_FOUND;
 }
 
 int getInputFloat(input_file *inp, const char *skey, float *dest, int mandatory) {
-	bool found;
-	std::string value = inp->get_value(skey, mandatory, found);
-	if(!found) {
+	input_value *value = inp->get_input_value(skey, mandatory);
+	if(value == nullptr) {
 		return KEY_NOT_FOUND;
 	}
 
-	*dest = std::atof(value.c_str());
+	*dest = value->number_value();
 
 	return KEY_FOUND;
 }
@@ -496,13 +541,12 @@ int getInputChar(input_file *inp, const char *skey, char *dest, int mandatory) {
 
 template<typename number>
 int getInputNumber(input_file *inp, const char *skey, number *dest, int mandatory) {
-	bool found;
-	std::string value = inp->get_value(skey, mandatory, found);
-	if(!found) {
+	input_value *value = inp->get_input_value(skey, mandatory);
+	if(value == nullptr) {
 		return KEY_NOT_FOUND;
 	}
 
-	*dest = (number) std::atof(value.c_str());
+	*dest = (number) value->number_value();
 
 	return KEY_FOUND;
 }
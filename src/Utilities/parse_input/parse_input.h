@@ -35,11 +35,21 @@ struct input_value {
 	std::vector<std::string> depends_on;
 	int read = 0;
 
+	/// true if expanded_value has been computed. Values that depend on other keys are also stale if the main input has changed since (see input_file::version)
+	bool expanded = false;
+	unsigned long long expanded_version = 0;
+
+	/// the expanded value converted to a number, which is computed only once per expansion
+	bool number_cached = false;
+	double cached_number = 0.;
+
 	input_value() : key(""), value("") {}
-	input_value(std::string k, std::string v) : key(k), value(v) {}
+	input_value(std::string k, std::string v);
 
 	bool has_dependencies();
+	bool is_expanded();
 	void expand_value(std::map<std::string, std::string> expanded_dependency_values);
+	double number_value();
 };
 
 typedef std::map<std::string, input_value> input_map;
@@ -56,6 +66,9 @@ struct input_file {
 
 	bool is_main_input = false;
 
+	/// incremented whenever a key is set or removed, so that cached expansions that depend on other keys can be invalidated
+	unsigned long long version = 0;
+
 	input_file(bool is_main);
 	input_file();
 	virtual ~input_file();
@@ -116,7 +129,18 @@ struct input_file {
 
 	void set_unread_keys();
 
-	std::string get_value(std::string key, int mandatory, bool &found);
+	/**
+	 * @brief Returns the (expanded) value associated to the given key, or nullptr if the key is not present.
+	 *
+	 * The expansion of $(...) and ${...} expressions is performed only the first time the key is read, and then only if the
+	 * value or the keys it depends on have changed.
+	 *
+	 * @param key
+	 * @param mandatory if true and the key is not found an exception is thrown
+	 * @return
+	 */
+	input_value *get_input_value(const std::string &key, int mandatory);
+	std::string get_value(const std::string &key, int mandatory, bool &found);
 	void set_value(std::string key, std::string value);
 	void unset_value(std::string key);
 
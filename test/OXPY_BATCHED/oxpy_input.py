@@ -0,0 +1,93 @@
+import numpy as np
+import oxpy
+
+# the quantities computed with the batched API are compared with those computed particle by particle
+# or by the simulation itself, and the outcome of each comparison is printed to results.dat
+def check(f, name, passed):
+    print(name, bool(passed), file=f)
+
+f = open("results.dat", "w")
+
+with oxpy.Context(print_coda=False):
+    my_input = oxpy.InputFile()
+    my_input.init_from_filename("input")
+    manager = oxpy.OxpyManager(my_input)
+    
+    interaction = manager.config_info().interaction
+    particles = manager.config_info().particles()
+    N = len(particles)
+    
+    pos = np.array(manager.config_info().flattened_conf.positions)
+    pos_init = pos.copy()
+    # a copy of the configuration where all the strands have been rigidly shifted by different amounts
+    shifted = pos.copy()
+    for p in particles:
+        shifted[p.index] += 0.02 * np.array([p.strand_id % 3, p.strand_id % 5, p.strand_id % 7])
+    
+    # pair_energies vs pair_interaction
+    pairs = np.array([[i, j] for i in range(N) for j in range(i + 1, N)])
+    E_pairs = manager.pair_energies(pairs)
+    E_ref = np.array([interaction.pair_interaction(particles[i], particles[j]) for i, j in pairs])
+    check(f, "pair_energies", np.allclose(E_pairs, E_ref, rtol=1e-10, atol=1e-12))
+    E_split = manager.pair_energies(pairs, split=True)
+    check(f, "pair_energies_split", np.allclose(E_split.sum(axis=1), E_ref, rtol=1e-10, atol=1e-12))
+    
+    # configuration_energies vs system_energy
+    E_conf = manager.configuration_energies(np.array([pos, shifted, pos]))
+    check(f, "configuration_energies", np.isclose(E_conf[0], manager.system_energy(), rtol=1e-10) and E_conf[0] == E_conf[2])
+    check(f, "configuration_energies_pairs", np.isclose(E_conf[0], E_ref.sum(), rtol=1e-10))
+    E_conf_split = manager.configuration_energies(np.array([pos, shifted]), split=True)
+    check(f, "configuration_energies_split", np.allclose(E_conf_split.sum(axis=1), E_conf[0:2], rtol=1e-10))
+    
+    # an overlap yields an infinite energy but does not affect the evaluation of the other configurations
+    overlap = pos.copy()
+    overlap[N // 2] = overlap[0]
+    E_overlap = manager.configuration_energies(np.array([overlap, pos]))
+    check(f, "configuration_energies_overlap", E_overlap[0] > 1e6 and E_overlap[1] == E_conf[0])
+    
+    # the simulation state is left untouched
+    check(f, "state_unchanged", np.array_equal(np.array(manager.config_info().flattened_conf.positions), pos))
+    
+    # configuration_forces vs the energies and vs finite differences of the energies
+    U, F, T = manager.configuration_forces(np.array([pos, shifted]))
+    U_MD, F_MD, T_MD = U, F, T
+    check(f, "configuration_forces_energies", np.allclose(U, E_conf[0:2], rtol=1e-10))
+    delta = 1e-5
+    passed = True
+    for idx in [0, 7, N // 2]:
+        for dim in range(3):
+            plus = shifted.copy()
+            plus[idx][dim] += delta
+            minus = shifted.copy()
+            minus[idx][dim] -= delta
+            E_plus, E_minus = manager.configuration_energies(np.array([plus, minus]))
+            F_num = -(E_plus - E_minus) / (2 * delta)
+            passed = passed and abs(F_num - F[1][idx][dim]) < 1e-6 * max(1., abs(F_num))
+    check(f, "configuration_forces_finite_differences", passed)
+    
+    # the forces and torques of the current configuration are the same as those computed by the MD backend
+    manager.run(1, False)
+    pos = np.array(manager.config_info().flattened_conf.positions)
+    U, F, T = manager.configuration_forces(np.array([pos]))
+    F_md = np.array([p.force for p in particles])
+    check(f, "configuration_forces_md", np.allclose(F[0], F_md, rtol=1e-8, atol=1e-10))
+    T_md = np.array([p.torque for p in particles])
+    check(f, "configuration_torques_md", np.allclose(T[0], T_md, rtol=1e-8, atol=1e-10))
+
+    del manager
+
+# Monte Carlo simulations use lists that contain each pair twice, but the results should not change
+with oxpy.Context(print_coda=False):
+    my_input = oxpy.InputFile()
+    my_input.init_from_filename("input")
+    my_input["sim_type"] = "MC"
+    my_input["ensemble"] = "NVT"
+    my_input["delta_translation"] = "0.1"
+    my_input["delta_rotation"] = "0.1"
+    manager = oxpy.OxpyManager(my_input)
+    
+    U, F, T = manager.configuration_forces(np.array([pos_init, shifted]))
+    check(f, "configuration_forces_mc", np.allclose(U, U_MD, rtol=1e-10) and np.allclose(F, F_MD, rtol=1e-8, atol=1e-10) and np.allclose(T, T_MD, rtol=1e-8, atol=1e-10))
+    del manager
+
+f.close()
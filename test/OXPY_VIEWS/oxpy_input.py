@@ -0,0 +1,63 @@
+import numpy as np
+import oxpy
+
+# configurations edited through the views returned by particle_view are compared with configurations read from a file,
+# and the outcome of each comparison is printed to results.dat
+def check(f, name, passed):
+    print(name, bool(passed), file=f)
+
+def make_manager(sim_type, conf_file=None):
+    my_input = oxpy.InputFile()
+    my_input.init_from_filename("input")
+    my_input["sim_type"] = sim_type
+    if conf_file is not None:
+        my_input["conf_file"] = conf_file
+    if sim_type == "MC":
+        my_input["ensemble"] = "NVT"
+        my_input["delta_translation"] = "0.05"
+        my_input["delta_rotation"] = "0.1"
+        # the energy stored by the backend is compared with the one computed from scratch at each step
+        my_input["check_energy_every"] = "1"
+        my_input["check_energy_threshold"] = "1e-4"
+    return oxpy.OxpyManager(my_input)
+
+# the first duplex is made of the first 16 nucleotides
+shift = np.array([0.3, 0., 0.])
+
+f = open("results.dat", "w")
+
+# MC: the energy stored by the backend must follow the changes made through the view, which are applied by run()
+with oxpy.Context(print_coda=False):
+    manager = make_manager("MC")
+    view = manager.particle_view("positions")
+    check(f, "zero_copy", view.is_zero_copy)
+    pos = np.asarray(view)
+    pos[0:16] += shift
+    check(f, "view_is_shared", np.array_equal(np.array(manager.config_info().flattened_conf.positions), pos))
+    manager.run(20, False)
+    check(f, "mc_stored_energy", True)
+    del view, pos
+    del manager
+
+# MD: editing the configuration through a view must be equivalent to starting from the edited configuration
+with oxpy.Context(print_coda=False):
+    manager = make_manager("MD")
+    pos = np.asarray(manager.particle_view("positions"))
+    pos[0:16] += shift
+    manager.apply_changes_to_simulation_data()
+    E_edited = manager.system_energy()
+    manager.print_configuration()
+    manager.run(100, False)
+    pos_edited = np.array(manager.config_info().flattened_conf.positions)
+    del pos
+    del manager
+
+with oxpy.Context(print_coda=False):
+    manager = make_manager("MD", "last_conf.dat")
+    check(f, "md_energy", np.isclose(manager.system_energy(), E_edited, rtol=1e-10))
+    manager.run(100, False)
+    pos_read = np.array(manager.config_info().flattened_conf.positions)
+    check(f, "md_trajectory", np.allclose(pos_edited, pos_read, rtol=0., atol=1e-10))
+    del manager
+
+f.close()
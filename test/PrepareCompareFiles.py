@@ -21,7 +21,7 @@ class CompareFileGenerator(object):
         os.chdir(self.folder)
         
         log_file = get_log_name(self.level)
-        to_execute = "%s %s log_file=%s no_stdout_energy=0" % (self.executable, self.system.input_name, log_file)
+        to_execute = "%s %s%s log_file=%s no_stdout_energy=0" % (self.executable, self.system.input_name, self.system.extra_args, log_file)
         p = sp.Popen(to_execute, shell=True, stdout=sp.PIPE, stderr=sp.PIPE)
         p.wait()
         
@@ -14,6 +14,7 @@ from multiprocessing import Lock
 SUFFIX_INPUT = "_input"
 SUFFIX_COMPARE = "_compare"
 SUFFIX_LOG = "_log.dat"
+SUFFIX_ARGS = "_args"
 
 def get_log_name(level):
     return "%s%s" % (level, SUFFIX_LOG)
@@ -58,7 +59,7 @@ class Runner(threading.Thread):
             if details["level"] == "oxpy":
                 to_execute = f"{details['executable']} {system.input_name}.py"
             else:
-                to_execute = f"{details['executable']} {system.input_name} log_file={log_file} no_stdout_energy=0" 
+                to_execute = f"{details['executable']} {system.input_name}{system.extra_args} log_file={log_file} no_stdout_energy=0" 
             
             try:
                 p = sp.Popen(to_execute, shell=True, stdout=sp.PIPE, stderr=sp.PIPE, cwd=folder, universal_newlines=True)
@@ -267,6 +268,13 @@ class System(object):
         self.input_name = level + SUFFIX_INPUT
         self.input_file = os.path.abspath(os.path.join(folder, level + SUFFIX_INPUT))
         
+        # additional command-line arguments (e.g. the box size required by confGenerator)
+        self.extra_args = ""
+        args_file = os.path.join(folder, level + SUFFIX_ARGS)
+        if os.path.exists(args_file) and os.path.isfile(args_file):
+            with open(args_file) as f:
+                self.extra_args = " " + " ".join(f.read().split())
+        
         self.analyser = Analyser(folder, level)
         
         self.error = False